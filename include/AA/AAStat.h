@@ -12,6 +12,7 @@
 
 #include "SVF-LLVM/BasicTypes.h"
 #include "SVFIR/SVFType.h"
+#include "CFLSolver/StatReport.h"
 #include <iostream>
 #include <map>
 #include <string>
@@ -29,8 +30,8 @@ class PEG;
 class AAStat
 {
 public:
-    typedef llvm::DenseMap<const char*, u64_t> NUMStatMap;
-    typedef llvm::DenseMap<const char*, double> TIMEStatMap;
+    typedef StatReport::NUMStatMap NUMStatMap;
+    typedef StatReport::TIMEStatMap TIMEStatMap;
 
     /// num counters
     u32_t numOfIteration;
@@ -39,6 +40,9 @@ public:
     u32_t numOfSEdges;
     u32_t numOfNodes;
     u32_t numOfEdges;
+    u32_t numOfComponents;
+    u32_t numOfPENodes;
+    u32_t numOfMappedSEdges;
 
     /// time counters
     double timeOfSolving;
@@ -46,9 +50,13 @@ public:
     double endTime;
     double sccTime;
     double gfTime;
+    double peTime;
     double interDyckTime;
     double gsTime;
 
+    /// Phase times and the JSON report
+    StatReport report;
+
 private:
     AliasAnalysis* aa;
 
@@ -69,6 +77,9 @@ public:
                                numOfSumEdges(0),
                                numOfNodes(0),
                                numOfEdges(0),
+                               numOfComponents(0),
+                               numOfPENodes(0),
+                               numOfMappedSEdges(0),
                                timeOfSolving(0)
     {
         startClk();
@@ -91,6 +102,7 @@ public:
 
     virtual void performStat();
     void pegStat();
+    void writeReport();
     void printStat(std::string str = "");
 };
 }
@@ -14,8 +14,10 @@
 #include "CFLData/PEG.h"
 #include "AAStat.h"
 #include "PEGFold.h"
+#include "PEGEquiv.h"
 #include "PEGInterDyck.h"
 #include "CFLData/ECG.h"
+#include "CFLData/PairIO.h"
 
 namespace SVF
 {
@@ -50,22 +52,31 @@ public:
 protected:
     /// Reanalyze flag
     bool reanalyze;
+    /// Whether the results are materialized
+    bool materialized;
     /// Graph
     PEG* _graph;
     std::string graphName;
+    /// f edges indexed by field offset, used for matching fbar V f
+    IndexedData gepData;
 
     /// Graph simplification
     SCC* scc;
     PEGFold* pegFold;
+    PEGEquiv* pegEquiv;
     PEGInterDyck* interDyck;
+    /// Solvers of weakly connected components
+    std::vector<AliasAnalysis*> components;
 
 public:
     AliasAnalysis(std::string& gName) : stat(nullptr),
                                         reanalyze(false),
+                                        materialized(false),
                                         _graph(nullptr),
                                         graphName(gName),
                                         scc(nullptr),
                                         pegFold(nullptr),
+                                        pegEquiv(nullptr),
                                         interDyck(nullptr)
     {};
 
@@ -75,7 +86,10 @@ public:
         delete _graph;
         delete scc;
         delete pegFold;
+        delete pegEquiv;
         delete interDyck;
+        for (AliasAnalysis* comp : components)
+            delete comp;
     }
 
     /// Graph operations
@@ -106,6 +120,8 @@ public:
     NodeBS checkAndAddEdges(NodeID src, const NodeBS& dstSet, Label lbl) override;
     NodeBS checkAndAddEdges(const NodeBS& srcSet, NodeID dst, Label lbl) override;
 
+    std::string getSymbolName(CFGSymbTy symb) override;
+
     /// stat
     //@{
     inline void dumpStat()
@@ -115,18 +131,49 @@ public:
     }
 
     virtual void countSumEdges();
+    void countComponentSumEdges();
+    u32_t countMappedEdges(NodeID src, const NodeBS& dsts) const;
+    //@}
+
+    /// Result materialization
+    //@{
+    /// Derive the result edges left implicit by the solver
+    virtual void materialize()
+    {}
+
+    /// Materialize the results of the solver or its components once, timed as the materialize phase
+    void materializeResults();
+    //@}
+
+    /// Result pairs
+    //@{
+    /// Collect the alias pairs, i.e., the V edges between reps
+    virtual void collectAliasPairs(PairMap& pairs);
+    void addAliasPairs(CFLData* data, PairMap& pairs);
+    /// Map the pairs between reps onto the original nodes
+    void expandMergedPairs(PairMap& pairs);
+    /// Write the alias pairs into -write-spairs and answer -queries over them, if set
+    void outputAliasPairs();
+    //@}
+
+    /// Solving weakly connected components independently
+    //@{
+    virtual AliasAnalysis* createComponentSolver() = 0;
+    void decompose();
+    void solveComponents();
     //@}
 
     static void timer()
     {
-        sleep(CFLOpt::timeOut);
-        assert(false && "Time out!!");
+        sleep(CFLOpt::deadline());
+        Checkpoint::preempt();
     }
 
     /// Graph simplifcation
     //@{
     void simplifyGraph();
     void graphFolding();
+    void pointerEquivalence();
     void interDyckGS();
     void SCCElimination();
     void SCCDetect();
@@ -145,6 +192,9 @@ public:
     StdAA(std::string graphName) : AliasAnalysis(graphName)
     {}
 
+    AliasAnalysis* createComponentSolver() override
+    { return new StdAA(graphName); }
+
     void initSolver() override;
 
     /// CFLItem operations
@@ -170,6 +220,9 @@ public:
     PocrAA(std::string gName) : AliasAnalysis(gName)
     {}
 
+    AliasAnalysis* createComponentSolver() override
+    { return new PocrAA(graphName); }
+
     void initSolver() override;
     void solve() override;
 
@@ -180,7 +233,12 @@ public:
     bool hasM(NodeID src, NodeID dst);
     void setM(NodeID src, NodeID dst);
 
+    void materialize() override;
     void countSumEdges() override;
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -197,26 +255,81 @@ public:
     typedef std::unordered_map<NodeID, std::unordered_set<NodeID>> ChildrenMap;
 
 protected:
-    ECG ecg;
+    ECG* ecg;
 
 public:
-    FocrAA(std::string gName) : AliasAnalysis(gName)
+    FocrAA(std::string gName) : AliasAnalysis(gName), ecg(nullptr)
     {}
 
+    ~FocrAA() override
+    { delete ecg; }
+
+    AliasAnalysis* createComponentSolver() override
+    { return new FocrAA(graphName); }
+
     void initSolver() override;
+    virtual void initECG();
     void solve() override;
 
-    void addArc(NodeID src, NodeID dst);
+    virtual void addArc(NodeID src, NodeID dst);
     void checkdEdges(NodeID src, NodeID dst);
     void checkfEdges(NodeID src, NodeID dst);
+    virtual void addV(NodeID u, NodeID v);
     void addV(ECGNode* u, ECGNode* v);
     bool setV(NodeID src, NodeID dst);
     bool hasM(NodeID src, NodeID dst);
     void setM(NodeID src, NodeID dst);
 
+    void materialize() override;
     void countSumEdges() override;
+
+    /// ECG statistics
+    //@{
+    virtual u32_t ecgChecks()
+    { return ecg->checks; }
+
+    virtual u32_t countReachablePairs()
+    { return ecg->countReachablePairs(); }
+    //@}
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
+
+/*!
+ * Focr AA with bit set-based ECG
+ */
+class BSFocrAA : public FocrAA
+{
+protected:
+    BSECG bsecg;
+
+public:
+    BSFocrAA(std::string gName) : FocrAA(gName)
+    {}
+
+    AliasAnalysis* createComponentSolver() override
+    { return new BSFocrAA(graphName); }
+
+    void initECG() override;
+
+    void addArc(NodeID src, NodeID dst) override;
+    void addV(NodeID u, NodeID v) override;
+
+    u32_t ecgChecks() override
+    { return bsecg.checks; }
+
+    u32_t countReachablePairs() override
+    { return bsecg.countReachablePairs(); }
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
+};
+
+
 /*!
  * Graspan (single thread for collecting derivation info)
  */
@@ -232,6 +345,9 @@ public:
             _oldData = new CFLData();
     }
 
+    AliasAnalysis* createComponentSolver() override
+    { return new GspanAA(graphName); }
+
     CFLData* oldData()
     {
         return _oldData;
@@ -242,6 +358,11 @@ public:
     virtual void solve();
 
     void countSumEdges();
+    void collectAliasPairs(PairMap& pairs) override;
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -254,6 +375,9 @@ public:
     GRAA(std::string gName) : StdAA(gName)
     {};
 
+    AliasAnalysis* createComponentSolver() override
+    { return new GRAA(graphName); }
+
     Set<Label> binarySumm(Label lty, Label rty);
 };
 
@@ -267,6 +391,9 @@ public:
     GRGspanAA(std::string gName) : GspanAA(gName)
     {}
 
+    AliasAnalysis* createComponentSolver() override
+    { return new GRGspanAA(graphName); }
+
     Set<Label> binarySumm(Label lty, Label rty);
 };
 
@@ -0,0 +1,47 @@
+/* -------------------- PEGEquiv.h ------------------ */
+//
+// Offline pointer equivalence for PEGs
+//
+
+#ifndef POCR_SVF_PEGEQUIV_H
+#define POCR_SVF_PEGEQUIV_H
+
+#include "CFLData/PEG.h"
+#include <tuple>
+
+namespace SVF
+{
+/*!
+ * Hash-based value numbering over PEGs.
+ * A node is labeled by its incoming a/d/f_i edges; nodes sharing a non-empty label are
+ * copies of the same values, thus alias exactly the same nodes and can be merged.
+ * Merging changes the labels of their successors, so labeling is repeated until no nodes merge.
+ */
+class PEGEquiv
+{
+public:
+    /// incoming edges as (rep of src, edge kind, field offset), sorted
+    typedef std::vector<std::tuple<NodeID, CFLEdge::GEdgeKind, u32_t>> Label;
+
+private:
+    PEG* peg;
+    u32_t numOfMergedNodes;
+
+public:
+    PEGEquiv(PEG* g) : peg(g), numOfMergedNodes(0)
+    {}
+
+    void mergeEquivalentNodes();
+
+    inline u32_t getNumOfMergedNodes() const
+    { return numOfMergedNodes; }
+
+private:
+    /// Group the nodes by their labels, returning the groups with more than one node
+    std::vector<std::pair<NodeID, NodeBS>> detectEquivalence();
+    void labelOf(CFLNode* node, Label& label) const;
+};
+}
+
+
+#endif //POCR_SVF_PEGEQUIV_H
@@ -43,6 +43,7 @@ public:
     Set<CFGSymbTy> emptyRules;                                          // X ::= epsilon
     Map<CFGSymbTy, Set<CFGSymbTy>> unaryRules;                          // X ::= Y
     Map<std::pair<CFGSymbTy, CFGSymbTy>, Set<CFGSymbTy>> binaryRules;   // X ::= Y Z
+    std::vector<std::pair<CFGSymbTy, std::vector<CFGSymbTy>>> longRules;  // X ::= Y1 ... Yn (n > 2), binarized before solving
 
     const Set<CFGSymbTy> emptySet;
 
@@ -101,6 +102,7 @@ public:
     void readProduction(std::string& line);
     void readUCFLSymbol(std::string& line, LineTy ty);
     void detectTransitiveSymbol();
+    void writeGrammar(std::string fname);
     void printCFGStat();
 };
 
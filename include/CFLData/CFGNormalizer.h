@@ -0,0 +1,59 @@
+/* -------------------- CFGNormalizer.h ------------------ */
+//
+// Binarization of grammars with long productions
+//
+
+#ifndef POCR_SVF_CFGNORMALIZER_H
+#define POCR_SVF_CFGNORMALIZER_H
+
+#include "CFLData/CFLEdge.h"
+#include "CFLData/CFLNode.h"
+#include "CFLData/CFG.h"
+
+namespace SVF
+{
+/*!
+ * Rewrite the long productions X ::= Y1 ... Yn (n > 2) of a grammar into binary ones.
+ * Every span Yi ... Yj of a production is derived by an intermediate symbol, and the
+ * split of each span is chosen to minimize the expected number of edges derived by the
+ * new intermediate symbols. Symbol sizes are estimated from the label frequencies of the
+ * input graph, assuming a random graph: a path labeled Y Z is expected |Y| * |Z| / |N| times.
+ * Intermediate symbols are named by their spans, so they are shared by productions.
+ */
+class CFGNormalizer
+{
+public:
+    typedef GenericGraph<CFLNode, CFLEdge> GraphTy;
+    typedef std::vector<CFGSymbTy> SymbVec;
+
+protected:
+    static const u32_t maxNumOfRounds = 32;
+
+    CFG* grammar;
+    double numOfNodes;
+    /// expected number of edges of each symbol
+    Map<CFGSymbTy, double> symbSizes;
+    u32_t numOfNewSymbols;
+
+public:
+    CFGNormalizer(CFG* _grammar) : grammar(_grammar), numOfNodes(1), numOfNewSymbols(0)
+    {}
+
+    void normalize(const GraphTy* graph);
+
+    inline u32_t getNumOfNewSymbols() const
+    { return numOfNewSymbols; }
+
+protected:
+    void estimateSymbolSizes(const GraphTy* graph);
+    double estimateSize(const SymbVec& rhs, u32_t begin, u32_t end);
+
+    void binarize(CFGSymbTy lhs, const SymbVec& rhs);
+    CFGSymbTy buildSpan(CFGSymbTy lhs, const SymbVec& rhs, u32_t begin, u32_t end,
+                        const std::vector<std::vector<u32_t>>& splits);
+    std::string getSpanName(CFGSymbTy lhs, const SymbVec& rhs, u32_t begin, u32_t end);
+};
+
+}
+
+#endif //POCR_SVF_CFGNORMALIZER_H
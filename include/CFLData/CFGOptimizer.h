@@ -0,0 +1,71 @@
+/* -------------------- CFGOptimizer.h ------------------ */
+//
+// Language-preserving rewriting of grammars before solving
+//
+
+#ifndef POCR_SVF_CFGOPTIMIZER_H
+#define POCR_SVF_CFGOPTIMIZER_H
+
+#include "CFLData/CFLEdge.h"
+#include "CFLData/CFLNode.h"
+#include "CFLData/CFG.h"
+
+namespace SVF
+{
+/*!
+ * Grammar optimizations that keep the facts of the count symbols:
+ * (1) rules with a symbol deriving no edge in the graph, or with an lhs unreachable
+ *     from the count symbols, are removed;
+ * (2) Kleene closures X ::= Y | X Y (or Y X) are rewritten into transitive symbols X ::= X X,
+ *     so that POCR and FOCR apply to them; closures with X ::= epsilon are kept, as POCR and
+ *     FOCR do not support transitive symbols with an epsilon rule;
+ * (3) unary rules X ::= Y are collapsed by substituting Y for X on the rhs of all rules,
+ *     unless X is a count or transitive symbol, saving one derived edge per Y edge.
+ */
+class CFGOptimizer
+{
+public:
+    typedef GenericGraph<CFLNode, CFLEdge> GraphTy;
+
+protected:
+    CFG* grammar;
+    u32_t numOfRemovedRules;
+    u32_t numOfNewTransitiveSymbols;
+    u32_t numOfCollapsedRules;
+
+public:
+    CFGOptimizer(CFG* _grammar) : grammar(_grammar),
+                                  numOfRemovedRules(0),
+                                  numOfNewTransitiveSymbols(0),
+                                  numOfCollapsedRules(0)
+    {}
+
+    void optimize(const GraphTy* graph);
+
+    /// Statistics
+    //@{
+    inline u32_t getNumOfRemovedRules() const
+    { return numOfRemovedRules; }
+
+    inline u32_t getNumOfNewTransitiveSymbols() const
+    { return numOfNewTransitiveSymbols; }
+
+    inline u32_t getNumOfCollapsedRules() const
+    { return numOfCollapsedRules; }
+    //@}
+
+    void discoverTransitiveSymbols();
+
+protected:
+    void removeUselessRules(const GraphTy* graph);
+    void collapseUnaryRules();
+
+    void addUnaryRule(CFGSymbTy lhs, CFGSymbTy rhs);
+    void addBinaryRule(CFGSymbTy lhs, CFGSymbTy rhs1, CFGSymbTy rhs2);
+    void removeUnaryRule(CFGSymbTy lhs, CFGSymbTy rhs);
+    void removeBinaryRule(CFGSymbTy lhs, CFGSymbTy rhs1, CFGSymbTy rhs2);
+};
+
+}
+
+#endif //POCR_SVF_CFGOPTIMIZER_H
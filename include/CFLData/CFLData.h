@@ -29,6 +29,21 @@ protected:
     DataMap predMap;
     const NodeBS emptyData;
     NodeBS diff;
+    /// Numbers of edges and of self-loop edges of each symbol, counted on insertion
+    std::vector<u64_t> numOfEdges;
+    std::vector<u64_t> numOfSelfEdges;
+
+    inline void countEdge(const NodeID src, const NodeID dst, const Label lbl)
+    {
+        if (lbl.first >= numOfEdges.size())
+        {
+            numOfEdges.resize(lbl.first + 1, 0);
+            numOfSelfEdges.resize(lbl.first + 1, 0);
+        }
+        numOfEdges[lbl.first]++;
+        if (src == dst)
+            numOfSelfEdges[lbl.first]++;
+    }
 
 public:
     // Constructor
@@ -42,8 +57,27 @@ public:
     {
         succMap.clear();
         predMap.clear();
+        numOfEdges.clear();
+        numOfSelfEdges.clear();
+    }
+
+    /// Edge counts, kept up to date by the insertion methods below
+    //@{
+    inline u64_t getNumOfEdges() const
+    {
+        u64_t num = 0;
+        for (u64_t n : numOfEdges)
+            num += n;
+        return num;
     }
 
+    inline u64_t getNumOfEdges(CFGSymbTy symb) const
+    { return symb < numOfEdges.size() ? numOfEdges[symb] : 0; }
+
+    inline u64_t getNumOfSelfEdges(CFGSymbTy symb) const
+    { return symb < numOfSelfEdges.size() ? numOfSelfEdges[symb] : 0; }
+    //@}
+
     inline const_iterator begin() const
     { return succMap.begin(); }
 
@@ -79,7 +113,8 @@ public:
     inline void addEdge(const NodeID src, const NodeID dst, const Label lbl)
     {
         succMap[src][lbl].set(dst);
-        predMap[dst][lbl].set(src);
+        if (predMap[dst][lbl].test_and_set(src))
+            countEdge(src, dst, lbl);
     }
 
     inline void addEdges(const NodeID src, const NodeBS& dstSet, const Label lbl)
@@ -87,7 +122,8 @@ public:
         if (succMap[src][lbl] |= dstSet)
         {
             for (const NodeID dst : dstSet)
-                predMap[dst][lbl].set(src);
+                if (predMap[dst][lbl].test_and_set(src))
+                    countEdge(src, dst, lbl);
         }
     }
 
@@ -96,14 +132,18 @@ public:
         if (predMap[dst][lbl] |= srcSet)
         {
             for (const NodeID src : srcSet)
-                succMap[src][lbl].set(dst);
+                if (succMap[src][lbl].test_and_set(dst))
+                    countEdge(src, dst, lbl);
         }
     }
 
     inline bool checkAndAddEdge(const NodeID src, const NodeID dst, const Label lbl)
     {
         succMap[src][lbl].test_and_set(dst);
-        return predMap[dst][lbl].test_and_set(src);
+        if (!predMap[dst][lbl].test_and_set(src))
+            return false;
+        countEdge(src, dst, lbl);
+        return true;
     }
 
     inline NodeBS checkAndAddEdges(const NodeID src, const NodeBS& dstSet, const Label lbl)
@@ -113,7 +153,10 @@ public:
         {
             for (const NodeID dst : dstSet)
                 if (predMap[dst][lbl].test_and_set(src))
+                {
                     newDsts.set(dst);
+                    countEdge(src, dst, lbl);
+                }
         }
         return newDsts;
     }
@@ -125,7 +168,10 @@ public:
         {
             for (const NodeID src : srcSet)
                 if (succMap[src][lbl].test_and_set(dst))
+                {
                     newSrcs.set(src);
+                    countEdge(src, dst, lbl);
+                }
         }
         return newSrcs;
     }
@@ -153,6 +199,151 @@ public:
 };
 
 
+/*!
+ * Secondary index for edges of a variant label (e.g., f_i or call_i), keyed by node and label index
+ */
+class IndexedData
+{
+public:
+    typedef std::map<u32_t, NodeBS> IdxMap;
+    typedef std::unordered_map<NodeID, IdxMap> DataMap;
+
+protected:
+    DataMap succMap;
+    DataMap predMap;
+    const IdxMap emptyIdxMap;
+    const NodeBS emptyData;
+
+public:
+    // Constructor
+    IndexedData()
+    {}
+
+    // Destructor
+    virtual ~IndexedData() = default;
+
+    virtual void clear()
+    {
+        succMap.clear();
+        predMap.clear();
+    }
+
+    inline const IdxMap& getSuccs(const NodeID key) const
+    {
+        auto it = succMap.find(key);
+        if (it == succMap.end())
+            return emptyIdxMap;
+        return it->second;
+    }
+
+    inline const IdxMap& getPreds(const NodeID key) const
+    {
+        auto it = predMap.find(key);
+        if (it == predMap.end())
+            return emptyIdxMap;
+        return it->second;
+    }
+
+    inline const NodeBS& getSuccs(const NodeID key, const u32_t idx) const
+    {
+        const IdxMap& idxMap = getSuccs(key);
+        auto it = idxMap.find(idx);
+        if (it == idxMap.end())
+            return emptyData;
+        return it->second;
+    }
+
+    inline const NodeBS& getPreds(const NodeID key, const u32_t idx) const
+    {
+        const IdxMap& idxMap = getPreds(key);
+        auto it = idxMap.find(idx);
+        if (it == idxMap.end())
+            return emptyData;
+        return it->second;
+    }
+
+    inline void addEdge(const NodeID src, const NodeID dst, const u32_t idx)
+    {
+        succMap[src][idx].set(dst);
+        predMap[dst][idx].set(src);
+    }
+
+    /// Call func(idx, lhsTgts, rhsTgts) for each index that appears in both lhs and rhs.
+    /// Only the indices of the smaller map are probed in the larger one.
+    template<typename Func>
+    static inline void forEachCommonIdx(const IdxMap& lhs, const IdxMap& rhs, Func func)
+    {
+        if (lhs.size() <= rhs.size())
+        {
+            for (auto& lIt : lhs)
+            {
+                auto rIt = rhs.find(lIt.first);
+                if (rIt != rhs.end())
+                    func(lIt.first, lIt.second, rIt->second);
+            }
+        }
+        else
+        {
+            for (auto& rIt : rhs)
+            {
+                auto lIt = lhs.find(rIt.first);
+                if (lIt != lhs.end())
+                    func(rIt.first, lIt->second, rIt.second);
+            }
+        }
+    }
+};
+
+
+/*!
+ * Slab allocator for solver-owned graph nodes; all objects are released in bulk by the destructor
+ */
+template<typename T, u32_t SlabSize = 4096>
+class NodeArena
+{
+protected:
+    std::vector<T*> slabs;
+    u32_t used;     // number of objects constructed in the last slab
+
+public:
+    NodeArena() : used(SlabSize)
+    {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    ~NodeArena()
+    { clear(); }
+
+    template<typename... Args>
+    inline T* alloc(Args&& ... args)
+    {
+        if (used == SlabSize)
+        {
+            slabs.push_back(static_cast<T*>(::operator new(sizeof(T) * SlabSize)));
+            used = 0;
+        }
+        return new(slabs.back() + used++) T(std::forward<Args>(args)...);
+    }
+
+    void clear()
+    {
+        for (u32_t i = 0; i < slabs.size(); ++i)
+        {
+            u32_t num = (i + 1 == slabs.size()) ? used : SlabSize;
+            for (u32_t j = 0; j < num; ++j)
+                slabs[i][j].~T();
+            ::operator delete(slabs[i]);
+        }
+        slabs.clear();
+        used = SlabSize;
+    }
+
+    inline u32_t size() const
+    { return slabs.empty() ? 0 : (slabs.size() - 1) * SlabSize + used; }
+};
+
+
 /*!
  * Hybrid graph representation for transitive relations
  */
@@ -161,10 +352,61 @@ class HybridData
 public:
     struct TreeNode
     {
+        /// Intrusive list of children. New children are prepended,
+        /// so a traversal in progress is not disturbed by insertions.
+        class ChildList
+        {
+        public:
+            class iterator
+            {
+            private:
+                TreeNode* cur;
+
+            public:
+                iterator(TreeNode* n) : cur(n)
+                {}
+
+                inline TreeNode* operator*() const
+                { return cur; }
+
+                inline iterator& operator++()
+                {
+                    cur = cur->nextSibling;
+                    return *this;
+                }
+
+                inline bool operator!=(const iterator& rhs) const
+                { return cur != rhs.cur; }
+            };
+
+        private:
+            TreeNode* head;
+
+        public:
+            ChildList() : head(nullptr)
+            {}
+
+            inline iterator begin() const
+            { return iterator(head); }
+
+            inline iterator end() const
+            { return iterator(nullptr); }
+
+            inline bool empty() const
+            { return head == nullptr; }
+
+            inline void insert(TreeNode* child)
+            {
+                child->nextSibling = head;
+                head = child;
+            }
+        };
+
         NodeID id;
-        std::unordered_set<TreeNode*> children;
+        TreeNode* nextSibling;
+        ChildList children;
 
-        TreeNode(NodeID nId) : id(nId)
+        TreeNode(NodeID nId) : id(nId), nextSibling(nullptr)
         {}
 
         inline bool operator==(const TreeNode& rhs) const
@@ -174,48 +416,150 @@ public:
         { return id < rhs.id; }
     };
 
+    /*!
+     * Open-addressing table from tree roots to the tree nodes of one graph node.
+     * Linear probing over a power-of-two array of (root, node) slots, kept at most half full.
+     */
+    class TreeIndex
+    {
+    public:
+        typedef std::pair<NodeID, TreeNode*> Slot;
+
+        class iterator
+        {
+        private:
+            const Slot* cur;
+            const Slot* last;
+
+            inline void skipEmpty()
+            {
+                while (cur != last && !cur->second)
+                    ++cur;
+            }
+
+        public:
+            iterator(const Slot* c, const Slot* l) : cur(c), last(l)
+            { skipEmpty(); }
+
+            inline const Slot& operator*() const
+            { return *cur; }
+
+            inline const Slot* operator->() const
+            { return cur; }
+
+            inline iterator& operator++()
+            {
+                ++cur;
+                skipEmpty();
+                return *this;
+            }
+
+            inline bool operator!=(const iterator& rhs) const
+            { return cur != rhs.cur; }
+        };
+
+    private:
+        std::vector<Slot> slots;
+        u32_t num;
+        u32_t shift;    // 32 - log2(slots.size())
+
+        inline u32_t slotOf(NodeID root) const
+        { return (root * 2654435769u) >> shift; }
+
+        inline u32_t probe(NodeID root) const
+        {
+            u32_t mask = slots.size() - 1;
+            u32_t i = slotOf(root);
+            while (slots[i].second && slots[i].first != root)
+                i = (i + 1) & mask;
+            return i;
+        }
+
+        void grow()
+        {
+            std::vector<Slot> old;
+            old.swap(slots);
+            slots.assign(old.empty() ? 2 : old.size() * 2, Slot(0, nullptr));
+            shift = 32 - __builtin_ctz(slots.size());
+            for (const Slot& slot : old)
+                if (slot.second)
+                    slots[probe(slot.first)] = slot;
+        }
+
+    public:
+        TreeIndex() : num(0), shift(32)
+        {}
+
+        inline iterator begin() const
+        { return iterator(slots.data(), slots.data() + slots.size()); }
+
+        inline iterator end() const
+        { return iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+
+        inline u32_t size() const
+        { return num; }
+
+        inline TreeNode* find(NodeID root) const
+        {
+            if (!num)
+                return nullptr;
+            return slots[probe(root)].second;
+        }
+
+        /// Return the slot of root, the slot is empty (nullptr) if root is newly inserted.
+        /// The table only grows on new roots, so looking up an existing root never invalidates iterators.
+        inline TreeNode*& insert(NodeID root)
+        {
+            if (num)
+            {
+                Slot& slot = slots[probe(root)];
+                if (slot.second)
+                    return slot.second;
+            }
+            if ((num + 1) * 2 > slots.size())
+                grow();
+            Slot& slot = slots[probe(root)];
+            slot.first = root;
+            num++;
+            return slot.second;
+        }
+    };
+
     u32_t checks;
 
-    Map<NodeID, std::unordered_map<NodeID, TreeNode*>> indMap;   // indMap[v][u] points to node v in tree(u)
+    Map<NodeID, TreeIndex> indMap;   // indMap[v][u] points to node v in tree(u)
 
 protected:
     std::unordered_map<NodeID, NodeBS> newEdgeMap;
+    NodeArena<TreeNode> treeNodes;
 
 public:
     HybridData() : checks(0)
     {}
 
-    ~HybridData()
-    {
-        for (auto iter1 : indMap)
-        {
-            for (auto iter2 : iter1.second)
-                delete iter2.second;
-        }
-    }
-
     inline bool hasInd(NodeID src, NodeID dst)
     {
         checks++;
         auto it = indMap.find(dst);
         if (it == indMap.end())
             return false;
-        return (it->second.find(src) != it->second.end());
+        return it->second.find(src) != nullptr;
     }
 
     /// Add a node dst to tree(src)
     inline TreeNode* addInd(NodeID src, NodeID dst)
     {
         checks++;
-        auto resIns = indMap[dst].insert(std::make_pair(src, new TreeNode(dst)));
-        if (resIns.second)
-            return resIns.first->second;
-        return nullptr;
+        TreeNode*& node = indMap[dst].insert(src);
+        if (node)
+            return nullptr;
+        node = treeNodes.alloc(dst);
+        return node;
     }
 
     /// Get the node dst in tree(src)
     inline TreeNode* getNode(NodeID src, NodeID dst)
-    { return indMap[dst][src]; }
+    { return indMap[dst].find(src); }
 
     /// add v into desc(x) as a child of u
     inline void insertTreeEdge(TreeNode* u, TreeNode* v)
@@ -227,8 +571,8 @@ public:
 
         if (!hasInd(src, dst))
         {
-            for (auto iter : indMap[src])
-                meld(iter.first, getNode(iter.first, src), getNode(dst, dst));
+            for (auto& iter : indMap[src])
+                meld(iter.first, iter.second, getNode(dst, dst));
         }
 
         return newEdgeMap;
@@ -43,6 +43,7 @@ public:
 
     void readGraph(std::string fname);   /// build from graph file
     void copyBuild(const CFLGraph& rhs);           /// copy builder
+    void copyBuild(const CFLGraph& rhs, const std::vector<NodeID>& nodes);   /// copy builder of the subgraph over nodes
 
     void destroy()
     {};
@@ -7,11 +7,16 @@
 #define POCR_SVF_ECG_H
 
 #include "CFLData.h"
+#include <algorithm>
 
 namespace SVF
 {
+class Checkpoint;
+
 class ECG
 {
+    friend class Checkpoint;
+
 public:
     enum ECGEdgeTy
     {
@@ -19,11 +24,56 @@ public:
         Back        // backward edges for tracking cycles
     };
 
+    struct ECGNode;
+
+    /*!
+     * Compact adjacency list, ECG nodes keep few neighbours after transitive reduction
+     */
+    class AdjList
+    {
+    public:
+        typedef std::vector<ECGNode*>::const_iterator const_iterator;
+
+    private:
+        std::vector<ECGNode*> nodes;
+
+    public:
+        inline const_iterator begin() const
+        { return nodes.begin(); }
+
+        inline const_iterator end() const
+        { return nodes.end(); }
+
+        inline u32_t size() const
+        { return nodes.size(); }
+
+        inline bool empty() const
+        { return nodes.empty(); }
+
+        inline bool has(ECGNode* n) const
+        { return std::find(nodes.begin(), nodes.end(), n) != nodes.end(); }
+
+        inline void insert(ECGNode* n)
+        {
+            if (!has(n))
+                nodes.push_back(n);
+        }
+
+        inline void erase(ECGNode* n)
+        {
+            auto it = std::find(nodes.begin(), nodes.end(), n);
+            if (it == nodes.end())
+                return;
+            *it = nodes.back();
+            nodes.pop_back();
+        }
+    };
+
     struct ECGNode
     {
         NodeID id;
-        std::unordered_set<ECGNode*> successors;
-        std::unordered_set<ECGNode*> predecessors;
+        AdjList successors;
+        AdjList predecessors;
 
         ECGNode(NodeID i) : id(i)
         {}
@@ -68,22 +118,35 @@ public:
 
 protected:
     std::unordered_map<NodeID, NodeID> nodeToRepMap;
-    std::unordered_map<NodeID, ECGNode*> idToNodeMap;
-    std::unordered_map<NodeID, NodeBS> reachableMap;
+    std::vector<ECGNode*> idToNodeMap;      // indexed by node id
+    std::vector<NodeBS> reachableMap;       // indexed by node id
     std::unordered_map<NodeID, NodeBS> newEdgeMap;
 
     VisitedStack* visited;
+    NodeArena<ECGNode> ecgNodes;
 
 public:
     /// constructor
     ECG() : checks(0), visited(nullptr)
     {};
 
+    /// destructor, ECG nodes are released together with ecgNodes
+    virtual ~ECG()
+    { delete visited; }
+
+    /// Create an ECG with the search engine selected by CFLOpt::iterECG
+    static ECG* createECG();
+
     /// node methods
     //@{
     inline void addNode(NodeID id)
     {
-        idToNodeMap[id] = new ECGNode(id);
+        if (id >= idToNodeMap.size())
+        {
+            idToNodeMap.resize(id + 1, nullptr);
+            reachableMap.resize(id + 1);
+        }
+        idToNodeMap[id] = ecgNodes.alloc(id);
         setReachable(id, id);
     }
 
@@ -100,15 +163,14 @@ public:
     //@{
     inline ECGNode* getNode(NodeID id)
     {
-        auto it = idToNodeMap.find(id);
-        assert(it != idToNodeMap.end() && "Node not found!");
-        return it->second;
+        assert(id < idToNodeMap.size() && idToNodeMap[id] && "Node not found!");
+        return idToNodeMap[id];
     }
 
     inline bool hasEdge(NodeID src, NodeID dst)
     {
         ECGNode* srcNode = getNode(src);
-        return srcNode->successors.find(getNode(dst)) != srcNode->successors.end();
+        return srcNode->successors.has(getNode(dst));
     }
 
     inline void addEdge(NodeID src, NodeID dst)
@@ -150,7 +212,7 @@ public:
     inline bool isReachable(NodeID n, NodeID tgt)
     {
         checks++;
-        return reachableMap[n].test(tgt);
+        return n < reachableMap.size() && reachableMap[n].test(tgt);
     }
 
     inline void setReachable(NodeID n, NodeID tgt)
@@ -163,15 +225,48 @@ public:
     /// graph methods
     std::unordered_map<NodeID, NodeBS>& insertForwardEdge(NodeID i, NodeID j);
     std::unordered_map<NodeID, NodeBS>& insertBackEdge(NodeID i, NodeID j);
-    void searchForward(ECGNode* vi, ECGNode* vj);
-    void searchBackward(ECGNode* vi, ECGNode* vj);
-    void searchBackwardInCycle(ECGNode* vi, ECGNode* vj);   // no use vj
-    void simplifyCycle(ECGNode* vi);
+    virtual void searchForward(ECGNode* vi, ECGNode* vj);
+    virtual void searchBackward(ECGNode* vi, ECGNode* vj);
+    virtual void searchBackwardInCycle(ECGNode* vi, ECGNode* vj);   // no use vj
+    virtual void simplifyCycle(ECGNode* vi);
     void stepInto(ECGNode* vi);
 
     /// calculator
     u32_t countReachablePairs();
-    void countECGEdges();
+    u32_t countECGEdges();
+    void collectReachablePairs(std::map<NodeID, NodeBS>& pairs) const;
+};
+
+
+/*!
+ * ECG with iterative searches over explicit stacks, safe for long value-flow chains.
+ * Nodes visited in cycle simplification are marked with epoch stamps instead of a hash set.
+ */
+class IterECG : public ECG
+{
+protected:
+    std::vector<ECGNode*> nodeStack;
+    std::vector<u32_t> visitStamps;     // indexed by node id
+    u32_t epoch;
+
+    inline void markVisited(ECGNode* n)
+    {
+        if (n->id >= visitStamps.size())
+            visitStamps.resize(idToNodeMap.size(), 0);
+        visitStamps[n->id] = epoch;
+    }
+
+    inline bool isVisited(ECGNode* n) const
+    { return n->id < visitStamps.size() && visitStamps[n->id] == epoch; }
+
+public:
+    IterECG() : epoch(0)
+    {}
+
+    void searchForward(ECGNode* vi, ECGNode* vj) override;
+    void searchBackward(ECGNode* vi, ECGNode* vj) override;
+    void searchBackwardInCycle(ECGNode* vi, ECGNode* vj) override;
+    void simplifyCycle(ECGNode* vi) override;
 };
 
 
@@ -180,17 +275,24 @@ public:
  */
 class BSECG
 {
+    friend class Checkpoint;
+
 public:
     typedef std::pair<NodeID, NodeID> ECGEdge;
 
+    /// calculators
+    u32_t checks;
+
 protected:
     std::unordered_map<NodeID, NodeBS> predMap;
     std::unordered_map<NodeID, NodeBS> succMap;
     std::unordered_map<NodeID, NodeBS> reachableMap;
+    std::unordered_map<NodeID, NodeBS> newEdgeMap;
     const NodeBS emptyBS;
 
 public:
-    BSECG() = default;
+    BSECG() : checks(0)
+    {}
 
     /// node methods
     //@{
@@ -248,19 +350,30 @@ public:
     /// Reachability info methods
     //@{
     inline bool isReachable(NodeID n, NodeID tgt)
-    { return reachableMap[n].test(tgt); }
+    {
+        checks++;
+        return reachableMap[n].test(tgt);
+    }
 
     inline void setReachable(NodeID n, NodeID tgt)
     { reachableMap[n].set(tgt); }
+
+    inline void recordNewEdge(NodeID n, NodeID tgt)
+    { newEdgeMap[n].set(tgt); }
     //@}
 
-    /// graph methods
-    void insertForthEdge(NodeID i, NodeID j);
-    void insertBackEdge(NodeID i, NodeID j);
+    /// graph methods, the returned maps hold the reachable pairs created by the insertion
+    std::unordered_map<NodeID, NodeBS>& insertForthEdge(NodeID i, NodeID j);
+    std::unordered_map<NodeID, NodeBS>& insertBackEdge(NodeID i, NodeID j);
     void searchForth(NodeID i, NodeID j);
     void searchBack(NodeID i, NodeID j);
 
     void searchBackInCycle(NodeID i, NodeID j);   // no use vj
+
+    /// calculator
+    u32_t countReachablePairs();
+    u32_t countECGEdges();
+    void collectReachablePairs(std::map<NodeID, NodeBS>& pairs) const;
 };
 
 
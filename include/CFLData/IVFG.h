@@ -49,6 +49,7 @@ public:
 
     void readGraph(std::string fname);   /// build from graph file
     void copyBuild(const IVFG& rhs);  /// copy builder
+    void copyBuild(const IVFG& rhs, const std::vector<NodeID>& nodes);   /// copy builder of the subgraph over nodes
 
     /// copy constructor
     IVFG(const IVFG& rhs)
@@ -136,6 +137,12 @@ public:
         return nodeToSubsMap[id];
     }
 
+    /// whether any node has been merged into a rep
+    inline bool hasMergedNodes() const
+    {
+        return !nodeToRepMap.empty();
+    }
+
     inline void setRep(NodeID node, NodeID rep)
     {
         nodeToRepMap[node] = rep;
@@ -154,6 +161,7 @@ public:
 
     /// merge nodes
     void mergeNodeToRep(NodeID nodeId, NodeID newRepId);
+    void mergeNodesToReps(const std::vector<std::pair<NodeID, NodeBS>>& groups);
     void reTargetDstOfEdge(CFLEdge* edge, CFLNode* newDstNode);
     void reTargetSrcOfEdge(CFLEdge* edge, CFLNode* newSrcNode);
     bool moveInEdgesToRepNode(CFLNode* node, CFLNode* rep);
@@ -48,6 +48,7 @@ public:
 
     void readGraph(std::string fname);   /// build from graph file
     void copyBuild(const PEG& rhs);           /// copy builder
+    void copyBuild(const PEG& rhs, const std::vector<NodeID>& nodes);   /// copy builder of the subgraph over nodes
 
     void destroy()
     {};
@@ -146,6 +147,21 @@ public:
         return nodeToSubsMap[id];
     }
 
+    /// number of original nodes represented by a node
+    inline u32_t numOfSubNodes(NodeID id) const
+    {
+        NodeToSubsMap::const_iterator it = nodeToSubsMap.find(id);
+        if (it == nodeToSubsMap.end())
+            return 1;
+        return it->second.count() + !it->second.test(id);
+    }
+
+    /// whether any node has been merged into a rep
+    inline bool hasMergedNodes() const
+    {
+        return !nodeToRepMap.empty();
+    }
+
     inline void setRep(NodeID node, NodeID rep)
     {
         nodeToRepMap[node] = rep;
@@ -164,6 +180,7 @@ public:
 
     /// merge nodes
     void mergeNodeToRep(NodeID nodeId, NodeID newRepId);
+    void mergeNodesToReps(const std::vector<std::pair<NodeID, NodeBS>>& groups);
     void reTargetDstOfEdge(CFLEdge* edge, CFLNode* newDstNode);
     void reTargetSrcOfEdge(CFLEdge* edge, CFLNode* newSrcNode);
     bool moveInEdgesToRepNode(CFLNode* node, CFLNode* rep);
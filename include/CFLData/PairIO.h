@@ -0,0 +1,163 @@
+/* -------------------- PairIO.h ------------------ */
+//
+// Bulk export and import of result pairs
+//
+
+#ifndef POCR_SVF_PAIRIO_H
+#define POCR_SVF_PAIRIO_H
+
+#include "CFLData.h"
+#include <cstdio>
+#include <map>
+
+namespace SVF
+{
+/// Result pairs grouped by source, e.g., the S pairs, alias pairs or value-flow pairs of a run
+typedef std::map<NodeID, NodeBS> PairMap;
+
+/*!
+ * Buffered writer of result pairs in one of two formats:
+ *  - Text: one "src\tdst" line per pair;
+ *  - Binary: the magic "PCFP" and a version as 32-bit words, followed by a record per source holding
+ *    the source, the number of destinations and the ascending destinations as gaps from their predecessors
+ *    (the first one from 0), all as LEB128 varints. Records run to the end of the file.
+ */
+class PairWriter
+{
+public:
+    enum Format
+    {
+        Text,
+        Binary
+    };
+
+    static const u32_t magic = 0x50464350;     // "PCFP"
+    static const u32_t version = 1;
+
+protected:
+    static const u32_t bufferSize = 1 << 20;
+
+    FILE* file;
+    Format format;
+    std::vector<char> buffer;
+    u32_t used;
+    u64_t numOfPairs;
+    bool failed;
+
+public:
+    PairWriter(const std::string& fName, Format fmt);
+
+    ~PairWriter()
+    { close(); }
+
+    inline bool isOpen() const
+    { return file != nullptr; }
+
+    inline u64_t getNumOfPairs() const
+    { return numOfPairs; }
+
+    /// Write the pairs from src to each of dsts
+    void write(NodeID src, const NodeBS& dsts);
+    void write(const PairMap& pairs);
+
+    /// Flush and close the file, false if any write failed
+    bool close();
+
+    /// Write all pairs into fName
+    static bool writePairs(const std::string& fName, const PairMap& pairs, Format fmt);
+
+protected:
+    void flush();
+
+    inline void reserve(u32_t size)
+    {
+        if (used + size > bufferSize)
+            flush();
+    }
+
+    inline void putVarint(u32_t val)
+    {
+        while (val >= 0x80)
+        {
+            buffer[used++] = (char) (val | 0x80);
+            val >>= 7;
+        }
+        buffer[used++] = (char) val;
+    }
+
+    inline void putDecimal(u32_t val)
+    {
+        char digits[10];
+        u32_t n = 0;
+        do
+        {
+            digits[n++] = (char) ('0' + val % 10);
+            val /= 10;
+        } while (val);
+        while (n)
+            buffer[used++] = digits[--n];
+    }
+};
+
+
+/*!
+ * Reader of the files written by PairWriter, detecting the format by the magic
+ */
+class PairReader
+{
+public:
+    typedef PairWriter::Format Format;
+
+protected:
+    static const u32_t bufferSize = 1 << 20;
+
+    FILE* file;
+    Format format;
+    std::vector<char> buffer;
+    u32_t pos;
+    u32_t size;
+    bool valid;
+    /// the text format holds one pair a line, the line following the last source read
+    bool hasPending;
+    NodeID pendingSrc;
+    NodeID pendingDst;
+
+public:
+    PairReader(const std::string& fName);
+
+    ~PairReader()
+    {
+        if (file)
+            fclose(file);
+    }
+
+    /// Whether the file is open and well-formed so far
+    inline bool isValid() const
+    { return file != nullptr && valid; }
+
+    inline Format getFormat() const
+    { return format; }
+
+    /// Read the next source with its destinations, false at the end of the file or on a malformed file
+    bool next(NodeID& src, NodeBS& dsts);
+
+    /// Read all remaining pairs into pairs, returning the number of pairs read
+    u64_t readAll(PairMap& pairs);
+
+protected:
+    inline bool fill()
+    {
+        if (pos < size)
+            return true;
+        size = fread(buffer.data(), 1, bufferSize, file);
+        pos = 0;
+        return size > 0;
+    }
+
+    bool getVarint(u32_t& val);
+    bool getTextPair(NodeID& src, NodeID& dst);
+};
+
+}
+
+#endif //POCR_SVF_PAIRIO_H
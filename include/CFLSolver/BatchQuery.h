@@ -0,0 +1,81 @@
+/* -------------------- BatchQuery.h ------------------ */
+//
+// Batch answering of reachability and alias queries over result pairs
+//
+
+#ifndef POCR_SVF_BATCHQUERY_H
+#define POCR_SVF_BATCHQUERY_H
+
+#include "CFLData/PairIO.h"
+#include <algorithm>
+
+namespace SVF
+{
+/*!
+ * Lookup index of result pairs in compressed sparse rows: the destinations of src are
+ * the sorted slice dsts[offsets[src], offsets[src + 1]), searched by binary search
+ */
+class PairIndex
+{
+protected:
+    std::vector<u64_t> offsets;
+    std::vector<NodeID> dsts;
+
+public:
+    PairIndex()
+    {}
+
+    void build(const PairMap& pairs);
+
+    inline bool contains(NodeID src, NodeID dst) const
+    {
+        if ((u64_t) src + 1 >= offsets.size())
+            return false;
+        auto begin = dsts.begin() + offsets[src];
+        auto end = dsts.begin() + offsets[src + 1];
+        return std::binary_search(begin, end, dst);
+    }
+
+    inline u64_t getNumOfPairs() const
+    { return dsts.size(); }
+};
+
+
+/*!
+ * Answers a batch of "src dst" queries, i.e., whether (src, dst) is a result pair: mayAlias(p, q) over the
+ * V pairs of aa, reaches(src, dst) over the A pairs of vf and over the S pairs of cfl. The pairs are given over
+ * the original nodes, so queries may name nodes merged away by -scc, -pe or graph folding.
+ * The queries are answered in parallel chunks, and the throughput is printed with the statistics.
+ */
+class BatchQuery
+{
+public:
+    typedef std::pair<NodeID, NodeID> QueryTy;
+
+protected:
+    PairIndex index;
+    std::vector<QueryTy> queries;
+    std::vector<char> answers;
+    u64_t numOfPositives;
+
+public:
+    BatchQuery() : numOfPositives(0)
+    {}
+
+    /// Answer the queries of -queries over pairs, writing the answers into -query-out if set
+    static bool answer(const PairMap& pairs, const std::string& relation);
+
+    /// Answer the queries of -queries over the pairs saved in -query-result
+    static bool answerSaved(const std::string& relation);
+
+    bool readQueries(const std::string& fName);
+    void answerAll();
+    bool writeAnswers(const std::string& fName) const;
+
+protected:
+    static bool answer(BatchQuery& batch, double indexTime, const std::string& relation);
+};
+
+}
+
+#endif //POCR_SVF_BATCHQUERY_H
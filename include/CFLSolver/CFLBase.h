@@ -15,6 +15,9 @@
 #include <Util/SCC.h>
 #include "CFLData/CFLData.h"
 #include "CFLOpt.h"
+#include "Checkpoint.h"
+#include "DerivationProfile.h"
+#include "ProgressSampler.h"
 #include <fstream>
 #include <thread>
 #include <pthread.h>
@@ -88,10 +91,16 @@ protected:
     /// Alias dataset
     CFLData* _cflData;
     const NodeBS emptyBS;
+    /// Derivation counters, only collected with -profile-rules
+    DerivationProfile* profile;
+    /// Progress sampler of the run, shared by the components and only created with -progress
+    ProgressSampler* sampler;
+    u32_t numOfUnpublishedPops;
+    u32_t publishedWorklistSize;
 
 public:
     /// Constructor
-    CFLBase() : _cflData(NULL)
+    CFLBase() : _cflData(NULL), profile(nullptr), sampler(nullptr), numOfUnpublishedPops(0), publishedWorklistSize(0)
     {
         if (!_cflData)
             _cflData = new CFLData();
@@ -99,15 +108,71 @@ public:
 
     /// Destructor
     virtual ~CFLBase()
-    { delete _cflData; }
+    {
+        delete _cflData;
+        delete profile;
+    }
 
     CFLData* cflData()
     { return _cflData; }
 
+    /// Derivation profile
+    //@{
+    virtual std::string getSymbolName(CFGSymbTy symb)
+    { return std::to_string(symb); }
+
+    inline void dumpProfile()
+    {
+        if (profile)
+            profile->dump([this](CFGSymbTy symb)
+                          { return getSymbolName(symb); });
+    }
+    //@}
+
+    /// Progress sampling
+    //@{
+    inline void enterPhase(StatReport::Phase phase)
+    {
+        if (sampler)
+            sampler->setPhase(phase);
+    }
+
+    /// Publish the items popped and the worklist length since the last publication
+    inline void publishProgress()
+    {
+        if (!sampler)
+            return;
+        u32_t size = worklist.size();
+        sampler->publish(numOfUnpublishedPops, (s64_t) size - publishedWorklistSize);
+        numOfUnpublishedPops = 0;
+        publishedWorklistSize = size;
+    }
+    //@}
+
+    /// Checkpointing, solvers keeping state outside the data store and the worklist extend both
+    //@{
+    virtual void writeState(Checkpoint& ckpt)
+    {
+        ckpt.write(*cflData());
+        ckpt.write(worklist);
+    }
+
+    virtual void readState(Checkpoint& ckpt)
+    {
+        cflData()->clear();
+        ckpt.read(*cflData());
+        ckpt.read(worklist);
+    }
+    //@}
+
     // worklist operations
     //@{
     virtual inline CFLItem popFromWorklist()
-    { return worklist.pop(); }
+    {
+        if (sampler && ++numOfUnpublishedPops == ProgressSampler::publishInterval)
+            publishProgress();
+        return worklist.pop();
+    }
 
     virtual inline bool pushIntoWorklist(CFLItem item)
     { return worklist.push(item); }
@@ -154,7 +219,7 @@ public:
 
     virtual void solve()
     {
-        while (!isWorklistEmpty())
+        while (!isWorklistEmpty() && !Checkpoint::isPreempted())
         {
             CFLItem item = popFromWorklist();
             processCFLItem(item);
@@ -165,41 +230,61 @@ public:
     {
         /// Derive edges via unary production rules
         for (Label newTy : unarySumm(item.label()))
-            if (checkAndAddEdge(item.src(), item.dst(), newTy))
+        {
+            bool isNew = checkAndAddEdge(item.src(), item.dst(), newTy);
+            if (isNew)
                 pushIntoWorklist(item.src(), item.dst(), newTy);
+            if (profile && newTy.first)
+                profile->addDerivations(newTy.first, item.label().first, 0, 1, isNew);
+        }
 
         /// Derive edges via binary production rules
         //@{
         for (auto& iter : cflData()->getSuccs(item.dst()))
         {
             Label rty = iter.first;
+            if (profile)
+                profile->addFanOut(DerivationProfile::Succ, iter.second.count());
             for (Label newTy : binarySumm(item.label(), rty))
             {
 //                NodeBS diffDsts = checkAndAddEdges(item.src(), iter.second, newTy);
 //                for (NodeID diffDst : diffDsts)
 //                    pushIntoWorklist(item.src(), diffDst, newTy);
+                u64_t numOfNewFacts = 0;
                 for (NodeID dst : iter.second)
                 {
                     if (checkAndAddEdge(item.src(), dst, newTy))
+                    {
                         pushIntoWorklist(item.src(), dst, newTy);
-
+                        numOfNewFacts++;
+                    }
                 }
+                if (profile && newTy.first)
+                    profile->addDerivations(newTy.first, item.label().first, rty.first, iter.second.count(), numOfNewFacts);
             }
         }
 
         for (auto& iter : cflData()->getPreds(item.src()))
         {
             Label lty = iter.first;
+            if (profile)
+                profile->addFanOut(DerivationProfile::Pred, iter.second.count());
             for (Label newTy : binarySumm(lty, item.label()))
             {
 //                NodeBS diffSrcs = checkAndAddEdges(iter.second, item.dst(), newTy);
 //                for (NodeID diffSrc : diffSrcs)
 //                    pushIntoWorklist(diffSrc, item.dst(), newTy);
+                u64_t numOfNewFacts = 0;
                 for (NodeID src : iter.second)
                 {
                     if (checkAndAddEdge(src, item.dst(), newTy))
+                    {
                         pushIntoWorklist(src, item.dst(), newTy);
+                        numOfNewFacts++;
+                    }
                 }
+                if (profile && newTy.first)
+                    profile->addDerivations(newTy.first, lty.first, item.label().first, iter.second.count(), numOfNewFacts);
             }
         }
         //@}
@@ -0,0 +1,53 @@
+/* -------------------- CFLComponents.h ------------------ */
+//
+// Weakly connected components of CFL graphs, solved independently
+//
+
+#ifndef POCR_SVF_CFLCOMPONENTS_H
+#define POCR_SVF_CFLCOMPONENTS_H
+
+#include "CFLData/CFLEdge.h"
+#include "CFLData/CFLNode.h"
+#include <functional>
+
+namespace SVF
+{
+/*!
+ * Decomposition of a graph into weakly connected components.
+ * No CFL-reachability fact crosses two components, so the components are packed into tasks
+ * which are solved by separate solver instances in parallel.
+ */
+class CFLComponents
+{
+public:
+    typedef GenericGraph<CFLNode, CFLEdge> GraphTy;
+    typedef std::vector<NodeID> NodeVec;
+
+protected:
+    /// node sets of the tasks, each holding one or more whole components
+    std::vector<NodeVec> tasks;
+    u32_t numOfComponents;
+
+public:
+    CFLComponents() : numOfComponents(0)
+    {}
+
+    /// Split the graph into components and pack small ones into tasks of similar sizes, largest task first
+    void decompose(const GraphTy* graph, u32_t numOfTasks);
+
+    inline const std::vector<NodeVec>& getTasks() const
+    { return tasks; }
+
+    inline u32_t getNumOfComponents() const
+    { return numOfComponents; }
+
+    /// Thread pool
+    //@{
+    static u32_t numOfThreads();
+    static void runInParallel(u32_t numOfJobs, const std::function<void(u32_t)>& job);
+    //@}
+};
+
+}
+
+#endif //POCR_SVF_CFLCOMPONENTS_H
@@ -14,20 +14,41 @@ public:
     CFLOpt(void) = delete;
 
     /// CFL Options
-    static const u32_t timeOut;
+    static const Option<u32_t> deadline;
+    static const Option<std::string> checkpointFName;
+    static const Option<std::string> resumeFName;
     static const Option<bool> PStat;
+    static const Option<std::string> statFName;
+    static const Option<bool> materialize;
     static const Option<bool> solveCFL;
     static const Option<std::string> outGraphFName;
     static const Option<bool> graphStat;
 
-    static const Option<bool> scc;
+    static Option<bool> optGrammar;
+    static const Option<bool> preFilter;
+    static Option<bool> scc;
+    static const Option<bool> parallelSCC;
+    static Option<bool> pe;
     static const Option<bool> gf;
     static const Option<bool> interDyck;
     static const Option<bool> graphSimp;
 
     static Option<bool> ucfl;
     static const Option<std::string> sPairsFName;
+    static const Option<bool> binaryPairs;
+    static const Option<std::string> queryFName;
+    static const Option<std::string> queryOutFName;
+    static const Option<std::string> queryResultFName;
+    static const Option<std::string> outGrammarFName;
     static const Option<bool> ecgSCC;
+    static const Option<bool> iterECG;
+    static const Option<std::string> traceFName;
+    static const Option<bool> profileRules;
+    static const Option<u32_t> progressInterval;
+    static const Option<std::string> progressFName;
+
+    static Option<bool> wcc;
+    static const Option<u32_t> numThreads;
 };
 
 }  // namespace SVF
@@ -10,6 +10,7 @@
 #include "CFLData/CFLGraph.h"
 #include "CFLStat.h"
 #include "CFLData/ECG.h"
+#include "RSM/RSM.h"
 
 namespace SVF
 {
@@ -25,28 +26,44 @@ public:
 protected:
     CFLData countData;
     bool reanalyze;
+    /// Whether the S pairs are materialized into stat->sEdgeSet
+    bool materialized;
     std::string grammarName;
     std::string graphName;
     CFG* _grammar;
     CFLGraph* _graph;
+    /// Solvers of weakly connected components
+    std::vector<StdCFL*> components;
+    /// Edge insertions are recorded as "src dst label index" lines if set
+    std::ofstream* traceFile;
 
 public:
     StdCFL(std::string& _grammarName, std::string& _graphName) : stat(nullptr),
                                                                  reanalyze(false),
+                                                                 materialized(false),
                                                                  grammarName(_grammarName),
                                                                  graphName(_graphName),
                                                                  _grammar(nullptr),
-                                                                 _graph(nullptr)
+                                                                 _graph(nullptr),
+                                                                 traceFile(nullptr)
     {}
 
     ~StdCFL() override
     {
+        delete stat;
+        stat = nullptr;
         delete _grammar;
         _grammar = nullptr;
         delete _graph;
         _graph = nullptr;
+        for (StdCFL* comp : components)
+            delete comp;
+        delete traceFile;
     }
 
+    virtual StdCFL* createComponentSolver()
+    { return new StdCFL(grammarName, graphName); }
+
     /// Grammar
     //@{
     virtual CFG* grammar()
@@ -62,6 +79,9 @@ public:
     //@}
 
     virtual void initialize();
+    virtual void readGrammar();
+    virtual void normalizeGrammar();
+    virtual void preFilter();
     virtual void initSolver();
     virtual void finalize();
     virtual void analyze();
@@ -69,11 +89,31 @@ public:
     /// stat
     void dumpStat();
     virtual void countSumEdges();
+    void countComponentSumEdges();
+
+    /// Result materialization
+    //@{
+    /// Collect the S pairs into stat->sEdgeSet
+    virtual void materialize();
+
+    /// Materialize the results of the solver or its components once, timed as the materialize phase
+    void materializeResults();
+
+    /// Whether the data store counts the S edges on insertion, i.e., a single count symbol holding
+    /// all S pairs by itself, so that counting needs no materialization
+    virtual bool isCountedOnInsertion();
+    //@}
+
+    /// Solving weakly connected components independently
+    //@{
+    void decompose();
+    void solveComponents();
+    //@}
 
     static void timer()
     {
-        sleep(CFLOpt::timeOut);
-        assert(false && "Time out!!");
+        sleep(CFLOpt::deadline());
+        Checkpoint::preempt();
     }
 
     /// summarizations via production rules
@@ -88,6 +128,13 @@ public:
     NodeBS checkAndAddEdges(NodeID src, const NodeBS& dstSet, Label lbl) override;
     NodeBS checkAndAddEdges(const NodeBS& srcSet, NodeID dst, Label lbl) override;
 
+    std::string getSymbolName(CFGSymbTy symb) override
+    { return grammar()->getSymbolString(symb); }
+
+    /// Traces name the labels like graph files, so that microbench -trace-label selects them the same way
+    inline void recordTrace(NodeID src, NodeID dst, Label lbl)
+    { *traceFile << src << "\t" << dst << "\t" << getSymbolName(lbl.first) << "\t" << lbl.second << "\n"; }
+
     void printCountEdges();
 };
 
@@ -109,6 +156,9 @@ public:
     PocrCFL(std::string& _grammarName, std::string& _graphName) : StdCFL(_grammarName, _graphName)
     {}
 
+    StdCFL* createComponentSolver() override
+    { return new PocrCFL(grammarName, graphName); }
+
     void initSolver() override;
     void procPrimaryItem(CFLItem item);
     bool pushIntoWorklist(NodeID src, NodeID dst, Label ty, bool isPrimary = true) override;
@@ -125,6 +175,10 @@ public:
     bool updateTrEdge(char lbl, NodeID px, TreeNode* py, NodeID sx, TreeNode* sy);
 
     void countSumEdges() override;
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -140,8 +194,15 @@ public:
     HPocrCFL(std::string& _grammarName, std::string& _graphName) : PocrCFL(_grammarName, _graphName)
     {}
 
+    StdCFL* createComponentSolver() override
+    { return new HPocrCFL(grammarName, graphName); }
+
     virtual void solve();
     virtual bool pushIntoWorklist(NodeID src, NodeID dst, Label ty, bool isPrimary = true);
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -163,11 +224,17 @@ public:
     FocrCFL(std::string& _grammarName, std::string& _graphName) : StdCFL(_grammarName, _graphName)
     {}
 
+    StdCFL* createComponentSolver() override
+    { return new FocrCFL(grammarName, graphName); }
+
     /// UCFL methods
     void initSolver() override;
+    virtual void initECGs();
     virtual void procPrimaryItem(CFLItem item);
     bool pushIntoWorklist(NodeID src, NodeID dst, Label ty, bool isPrimary = true) override;
     void processCFLItem(CFLItem item) override;
+    virtual void checkPreds(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst);
+    virtual void checkSuccs(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst);
     void checkPreds(Label newLbl, ECGNode* src, NodeID dst);
     void checkSuccs(Label newLbl, NodeID src, ECGNode* dst);
 
@@ -175,6 +242,39 @@ public:
     { return item.isPrimary(); }
 
     void countSumEdges() override;
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
+};
+
+
+/*!
+ * Fully-ordered CFL-reachability with bit set-based ECGs
+ */
+class BSFocrCFL : public FocrCFL
+{
+protected:
+    Map<CFGSymbTy, BSECG> bsecgs;
+
+public:
+    BSFocrCFL(std::string& _grammarName, std::string& _graphName) : FocrCFL(_grammarName, _graphName)
+    {}
+
+    StdCFL* createComponentSolver() override
+    { return new BSFocrCFL(grammarName, graphName); }
+
+    /// UCFL methods
+    void initECGs() override;
+    void procPrimaryItem(CFLItem item) override;
+    void checkPreds(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst) override;
+    void checkSuccs(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst) override;
+
+    void countSumEdges() override;
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -187,12 +287,23 @@ public:
     TRFocrCFL(std::string& _grammarName, std::string& _graphName) : FocrCFL(_grammarName, _graphName)
     {}
 
+    StdCFL* createComponentSolver() override
+    { return new TRFocrCFL(grammarName, graphName); }
+
     /// UCFL methods
     void procPrimaryItem(CFLItem item) override;
     NodeBS checkAndAddEdges(NodeID src, const NodeBS& dstSet, Label lbl) override;
     NodeBS checkAndAddEdges(const NodeBS& srcSet, NodeID dst, Label lbl) override;
 
     void countSumEdges() override;
+    void materialize() override;
+
+    bool isCountedOnInsertion() override
+    { return false; }
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -208,6 +319,9 @@ public:
     TRCFL(std::string& _grammarName, std::string& _graphName) : StdCFL(_grammarName, _graphName)
     {}
 
+    StdCFL* createComponentSolver() override
+    { return new TRCFL(grammarName, graphName); }
+
     /// UCFL methods
     bool pushIntoWorklist(NodeID src, NodeID dst, Label ty, bool isPrimary = true) override;
     void processCFLItem(CFLItem item) override;
@@ -220,7 +334,64 @@ public:
     static bool isPrimary(CFLItem& item)
     { return item.isPrimary(); }
 
+    void materialize() override;
+
+    /// the S pairs are split between cflData and secondaryData
+    bool isCountedOnInsertion() override
+    { return false; }
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
+};
+
+
+/*!
+ * CFL-reachability on a recursive state machine instead of a normalized grammar.
+ * A summary edge src --(q, q')--> dst denotes a path from src to dst driving the RSM from local state q
+ * to q' at the same box level. A box entered at a node and a local state records the frames waiting for
+ * its exit, i.e., the srcs and states of the summaries it extends and the box with its index.
+ */
+class RSMCFL : public StdCFL
+{
+public:
+    typedef RSM::GStateTy GStateTy;
+    typedef std::tuple<NodeID, u32_t, u32_t, u32_t> FrameTy;     // <src, local state, box, idx>
+
+protected:
+    RSM rsm;
+    /// RSM labels of the CFG symbols labeling the graph edges
+    Map<CFGSymbTy, char> symbToLabel;
+    /// frames entered at a node in a local state
+    Map<NodeID, Map<u32_t, std::set<FrameTy>>> frames;
+
+public:
+    RSMCFL(std::string& _rsmName, std::string& _graphName) : StdCFL(_rsmName, _graphName)
+    {}
+
+    StdCFL* createComponentSolver() override;
+
+    void readGrammar() override;
+    void initSolver() override;
+    void processCFLItem(CFLItem item) override;
     void countSumEdges() override;
+    void materialize() override;
+
+    /// the S pairs are the summaries of several local state pairs
+    bool isCountedOnInsertion() override
+    { return false; }
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
+
+protected:
+    inline Label edgeLabel(const CFLEdge* edge)
+    { return Label(symbToLabel[edge->getEdgeKind()], edge->getEdgeIdx()); }
+
+    void addSummary(NodeID src, NodeID dst, u32_t srcState, u32_t dstState);
+    void enterFrame(NodeID entry, u32_t state, const FrameTy& frame);
+    void exitFrame(const FrameTy& frame, NodeID node, u32_t state);
 };
 
 }
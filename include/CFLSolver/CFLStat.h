@@ -7,6 +7,7 @@
 
 #include "SVF-LLVM/BasicTypes.h"
 #include "SVFIR/SVFType.h"
+#include "CFLSolver/StatReport.h"
 
 namespace SVF
 {
@@ -20,8 +21,8 @@ class CFLGraph;
 class CFLStat
 {
 public:
-    typedef llvm::DenseMap<const char*, u64_t> NUMStatMap;
-    typedef llvm::DenseMap<const char*, double> TIMEStatMap;
+    typedef StatReport::NUMStatMap NUMStatMap;
+    typedef StatReport::TIMEStatMap TIMEStatMap;
 
     /// num counters
     u32_t numOfIteration;
@@ -30,12 +31,18 @@ public:
     u32_t numOfCountEdges;
     u32_t numOfNodes;
     u32_t numOfEdges;
+    u32_t numOfComponents;
+    u32_t numOfPrunedEdges;
 
     /// time counters
     double timeOfSolving;
     double startTime;
     double endTime;
     double gsTime;
+    double prefilterTime;
+
+    /// Phase times and the JSON report
+    StatReport report;
 
     /// A set for S edges
     std::map<NodeID, NodeBS> sEdgeSet;
@@ -61,6 +68,8 @@ public:
                          numOfCountEdges(0),
                          numOfNodes(0),
                          numOfEdges(0),
+                         numOfComponents(0),
+                         numOfPrunedEdges(0),
                          timeOfSolving(0)
     {
         startClk();
@@ -83,6 +92,7 @@ public:
 
     void performStat();
     void graphStat();
+    void writeReport();
     virtual void printStat(std::string str = "");
     void writeSPairsIntoFile(std::string fName);
 };
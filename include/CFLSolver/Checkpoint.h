@@ -0,0 +1,96 @@
+/* -------------------- Checkpoint.h ------------------ */
+//
+// Cooperative deadline and checkpoint files of the solvers
+//
+
+#ifndef POCR_SVF_CHECKPOINT_H
+#define POCR_SVF_CHECKPOINT_H
+
+#include "CFLData/CFLData.h"
+#include "CFLData/ECG.h"
+#include <atomic>
+#include <fstream>
+
+namespace SVF
+{
+class CFLBase;
+class CFLItem;
+
+/*!
+ * Solve loops poll isPreempted(), which is set by the -deadline timer or by SIGTERM.
+ * A preempted solver writes its state into a binary checkpoint file (-checkpoint): a header with
+ * the arguments of the run and the node count of the graph, the data store, the worklist, and the solver-specific
+ * structures written by CFLBase::writeState. A later run with -resume reads it back right after
+ * initSolver and continues solving where the preempted run stopped.
+ */
+class Checkpoint
+{
+public:
+    /// Exit status of a preempted run (EX_TEMPFAIL), telling batch schedulers to resubmit the job
+    static const int exitCode = 75;
+
+protected:
+    static std::atomic<bool> preempted;
+    static const u32_t magic = 0x504b4350;     // "PCKP"
+    static const u32_t version = 1;
+
+    std::ofstream out;
+    std::ifstream in;
+
+public:
+    /// Deadline
+    //@{
+    static inline bool isPreempted()
+    { return preempted.load(std::memory_order_relaxed); }
+
+    static inline void preempt()
+    { preempted.store(true, std::memory_order_relaxed); }
+
+    /// Preempt on SIGTERM instead of terminating
+    static void catchSignals();
+
+    /// Report the preemption, write the checkpoint if required, and exit with exitCode
+    static void suspend(CFLBase* solver, const std::string& key);
+
+    /// Read the checkpoint given by -resume, if any, into an initialized solver
+    static void resume(CFLBase* solver, const std::string& key);
+    //@}
+
+    /// Checkpoint files, identified by the run key and a key of the graph the solver runs on
+    //@{
+    static std::string getRunKey();
+    static bool save(CFLBase* solver, const std::string& fName, const std::string& key);
+    static bool restore(CFLBase* solver, const std::string& fName, const std::string& key);
+    //@}
+
+    /// Writing
+    //@{
+    void write(u32_t val);
+    void write(const std::string& str);
+    void write(const NodeBS& bs);
+    void write(CFLData& data);
+    void write(FIFOWorkList<CFLItem>& worklist);
+    void write(const HybridData& hybridData);
+    void write(const ECG& ecg);
+    void write(const BSECG& bsecg);
+    //@}
+
+    /// Reading, into structures already set up by initSolver
+    //@{
+    u32_t readU32();
+    std::string readString();
+    void read(NodeBS& bs);
+    void read(CFLData& data);
+    void read(FIFOWorkList<CFLItem>& worklist);
+    void read(HybridData& hybridData);
+    void read(ECG& ecg);
+    void read(BSECG& bsecg);
+
+    inline bool good() const
+    { return in.good(); }
+    //@}
+};
+
+}
+
+#endif //POCR_SVF_CHECKPOINT_H
@@ -0,0 +1,69 @@
+/* -------------------- DerivationProfile.h ------------------ */
+//
+// Per-production derivation counters and fan-out histograms of the standard solvers
+//
+
+#ifndef POCR_SVF_DERIVATIONPROFILE_H
+#define POCR_SVF_DERIVATIONPROFILE_H
+
+#include "CFLData/BasicUtils.h"
+#include <functional>
+#include <map>
+#include <tuple>
+
+namespace SVF
+{
+/*!
+ * Profile of the derivations of a solve (-profile-rules).
+ * Joining an item with a set of neighbour edges makes one attempt per neighbour;
+ * attempts deriving an edge that is already present are redundant re-derivations.
+ * Fan-outs are the sizes of the per-label successor/predecessor sets an item is joined with,
+ * kept in power-of-two buckets.
+ */
+class DerivationProfile
+{
+public:
+    typedef std::tuple<CFGSymbTy, CFGSymbTy, CFGSymbTy> Production;     // lhs, rhs1, rhs2 (0 for unary rules)
+    typedef std::function<std::string(CFGSymbTy)> SymbolNameFn;
+
+    struct Counters
+    {
+        u64_t attempts = 0;
+        u64_t newFacts = 0;
+    };
+
+    enum FanOutTy
+    {
+        Succ = 0,
+        Pred
+    };
+
+    static const u32_t numOfBuckets = 33;   // bucket 0 for empty sets, bucket k for sizes in [2^(k-1), 2^k)
+
+protected:
+    std::map<Production, Counters> productions;
+    u64_t fanOuts[2][numOfBuckets];
+
+public:
+    DerivationProfile() : fanOuts()
+    {}
+
+    inline void addDerivations(CFGSymbTy lhs, CFGSymbTy rhs1, CFGSymbTy rhs2, u64_t attempts, u64_t newFacts)
+    {
+        Counters& counters = productions[std::make_tuple(lhs, rhs1, rhs2)];
+        counters.attempts += attempts;
+        counters.newFacts += newFacts;
+    }
+
+    inline void addFanOut(FanOutTy ty, u32_t size)
+    { fanOuts[ty][size ? 32 - __builtin_clz(size) : 0]++; }
+
+    /// Add up the profile of a component solver
+    void merge(const DerivationProfile& rhs);
+
+    void dump(const SymbolNameFn& symbolName) const;
+};
+
+}
+
+#endif //POCR_SVF_DERIVATIONPROFILE_H
@@ -0,0 +1,88 @@
+/* -------------------- ParallelSCC.h ------------------ */
+//
+// Multi-threaded SCC detection over direct edges
+//
+
+#ifndef POCR_SVF_PARALLELSCC_H
+#define POCR_SVF_PARALLELSCC_H
+
+#include "CFLData/CFLEdge.h"
+#include "CFLData/CFLNode.h"
+#include <atomic>
+#include <mutex>
+
+namespace SVF
+{
+/*!
+ * Forward-backward SCC detection (FW-BW-Trim) over the direct edges of a graph.
+ * Nodes without direct preds or succs are trimmed first, the rest is split into
+ * weakly connected subproblems that are processed by a pool of threads.
+ * Each subproblem is split by the forward and backward closures of a pivot,
+ * and small subproblems are finished by Tarjan's algorithm.
+ */
+class ParallelSCC
+{
+public:
+    typedef GenericGraph<CFLNode, CFLEdge> GraphTy;
+    /// non-trivial SCCs, each with its rep (the smallest node id) and all its nodes
+    typedef std::vector<std::pair<NodeID, NodeBS>> SCCList;
+
+protected:
+    /// A subproblem: nodes sharing one color
+    struct Task
+    {
+        u32_t color;
+        std::vector<u32_t> nodes;
+    };
+
+    static const u32_t doneColor = UINT32_MAX;
+    static const u32_t tarjanThreshold = 1024;
+
+    GraphTy* graph;
+    /// dense node indices and direct edges in CSR form
+    //@{
+    std::vector<NodeID> idxToNode;
+    std::vector<u32_t> succOffsets;
+    std::vector<u32_t> succs;
+    std::vector<u32_t> predOffsets;
+    std::vector<u32_t> preds;
+    //@}
+
+    /// each node is owned by the task of its color; doneColor once its SCC is known
+    std::vector<std::atomic<u32_t>> colors;
+    std::atomic<u32_t> numOfColors;
+    /// per-node scratch data, only touched by the owner task
+    //@{
+    std::vector<u32_t> fwMarks;
+    std::vector<u32_t> bwMarks;
+    std::vector<u32_t> dfsIndex;
+    std::vector<u32_t> dfsLow;
+    std::vector<char> onStack;
+    //@}
+
+    SCCList sccs;
+    std::mutex sccMutex;
+
+public:
+    ParallelSCC(GraphTy* g) : graph(g), numOfColors(0)
+    {}
+
+    void find();
+
+    inline const SCCList& getSCCs() const
+    { return sccs; }
+
+protected:
+    void buildCSR();
+    std::vector<Task> trim();
+    void splitTask(Task& task, std::vector<Task>& newTasks);
+    void tarjan(Task& task);
+    void addSCC(const std::vector<u32_t>& nodes);
+
+    inline bool owns(u32_t color, u32_t n) const
+    { return colors[n].load(std::memory_order_relaxed) == color; }
+};
+
+}
+
+#endif //POCR_SVF_PARALLELSCC_H
@@ -0,0 +1,69 @@
+/* -------------------- ProgressSampler.h ------------------ */
+//
+// Background sampling of the progress of long runs
+//
+
+#ifndef POCR_SVF_PROGRESSSAMPLER_H
+#define POCR_SVF_PROGRESSSAMPLER_H
+
+#include "CFLSolver/StatReport.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace SVF
+{
+/*!
+ * A thread sampling the current phase, the pending and processed worklist items, the processing rate
+ * and the RSS every -progress seconds, printing a progress line to stderr and optionally
+ * appending the samples to a tab-separated time series (-progress-file).
+ * Solvers publish their item counts in batches of publishInterval pops, so sampling costs
+ * the solving thread one counter increment per item; component solvers share the sampler of the run.
+ */
+class ProgressSampler
+{
+public:
+    static const u32_t publishInterval = 4096;
+
+protected:
+    std::atomic<u32_t> phase;
+    std::atomic<u64_t> numOfProcessed;
+    std::atomic<s64_t> numOfPending;
+
+    u32_t interval;     // in seconds
+    std::ofstream* seriesFile;
+    std::chrono::steady_clock::time_point startTime;
+    double lastTime;
+    u64_t lastProcessed;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable stopCond;
+    bool stopped;
+
+public:
+    ProgressSampler(u32_t _interval, const std::string& seriesFName);
+
+    /// Take a last sample and stop the thread
+    ~ProgressSampler();
+
+    inline void setPhase(StatReport::Phase p)
+    { phase.store(p, std::memory_order_relaxed); }
+
+    /// Add the items popped and the change of the worklist length since the last publication
+    inline void publish(u64_t processedDelta, s64_t pendingDelta)
+    {
+        numOfProcessed.fetch_add(processedDelta, std::memory_order_relaxed);
+        numOfPending.fetch_add(pendingDelta, std::memory_order_relaxed);
+    }
+
+protected:
+    void run();
+    void sample();
+};
+
+}
+
+#endif //POCR_SVF_PROGRESSSAMPLER_H
@@ -0,0 +1,84 @@
+/* -------------------- RegularFilter.h ------------------ */
+//
+// Regular approximation of grammars for pruning irrelevant edges
+//
+
+#ifndef POCR_SVF_REGULARFILTER_H
+#define POCR_SVF_REGULARFILTER_H
+
+#include "CFLData/CFLEdge.h"
+#include "CFLData/CFLNode.h"
+#include "CFLData/CFG.h"
+
+namespace SVF
+{
+/*!
+ * Regular over-approximation of the language of the count symbols of a grammar.
+ * A string is accepted if its first and last terminals and every two adjacent terminals
+ * may occur so in some derived string, and if the parenthesis terminals in it are balanced
+ * per kind, ignoring their indices and nesting order. Terminals form parentheses (o, c) when
+ * they occur in the grammar only as X ::= o Y and Z ::= X c, with X used nowhere else.
+ *
+ * An edge lying on no accepted path lies on no path of a count symbol, so it can be
+ * removed before solving. Paths are traversed in the product of the graph and the
+ * automaton of the approximation, whose states of a node are kept in one 64-bit set.
+ */
+class RegularFilter
+{
+public:
+    typedef GenericGraph<CFLNode, CFLEdge> GraphTy;
+    typedef u64_t StateSet;
+
+protected:
+    static const u32_t maxNumOfStates = 64;
+
+    /// terminals of the grammar, indexed densely, and edge kinds labeled by them
+    Map<CFGSymbTy, u32_t> symbToTerm;
+    Map<CFLEdge::GEdgeKind, u32_t> kindToTerm;
+    u32_t numOfTerms;
+    u32_t numOfParens;
+    bool enabled;
+
+    /// transitions[s * numOfTerms + t]: the states reached from state s by terminal t
+    std::vector<StateSet> transitions;
+    StateSet startStates;
+    StateSet acceptStates;
+
+public:
+    /// Build the approximation of a grammar whose edge kinds are its symbol ids
+    RegularFilter(const CFG& grammar);
+    /// Build the approximation of a grammar whose terminals label the given edge kinds
+    RegularFilter(const CFG& grammar, const Map<CFLEdge::GEdgeKind, CFGSymbTy>& kindToSymb);
+
+    /// Whether the approximation can tell anything, i.e., the grammar has count symbols and is small enough
+    inline bool isEnabled() const
+    { return enabled; }
+
+    /// Edges on no accepted path
+    std::vector<CFLEdge*> findIrrelevantEdges(const GraphTy* graph) const;
+
+protected:
+    void buildAutomaton(const CFG& grammar);
+
+    inline StateSet next(StateSet states, u32_t term) const
+    {
+        StateSet nextStates = 0;
+        for (u32_t s = 0; states; ++s, states >>= 1)
+            if (states & 1)
+                nextStates |= transitions[s * numOfTerms + term];
+        return nextStates;
+    }
+
+    inline StateSet prev(StateSet states, u32_t term) const
+    {
+        StateSet prevStates = 0;
+        for (u32_t s = 0; s < maxNumOfStates; ++s)
+            if (transitions[s * numOfTerms + term] & states)
+                prevStates |= (StateSet) 1 << s;
+        return prevStates;
+    }
+};
+
+}
+
+#endif //POCR_SVF_REGULARFILTER_H
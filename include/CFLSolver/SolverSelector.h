@@ -0,0 +1,92 @@
+/* -------------------- SolverSelector.h ------------------ */
+//
+// Selection of solvers and simplifications from input features
+//
+
+#ifndef POCR_SVF_SOLVERSELECTOR_H
+#define POCR_SVF_SOLVERSELECTOR_H
+
+#include "CFLData/CFG.h"
+#include "CFLSolver/CFLOpt.h"
+
+namespace SVF
+{
+/*!
+ * Pick a solver and simplification options (-auto) from cheap features of the grammar
+ * and of the graph file, which is scanned once without building a CFL graph.
+ * The rules follow the measurements on the graphs in tests/:
+ * POCR and FOCR outperform the standard solver by one to two orders of magnitude once the
+ * grammar has a transitive symbol; FOCR is the fastest on value-flow graphs, and POCR is on
+ * par with it on PEGs, where SCC and pointer-equivalence merging pay off if copy edges form cycles.
+ * A solver or simplification option given on the command line takes precedence over the selection.
+ */
+class SolverSelector
+{
+public:
+    enum SolverTy
+    {
+        Std,
+        Pocr,
+        Focr,
+        Given       // the solver given on the command line
+    };
+
+    /// Features of a graph file
+    struct GraphFeatures
+    {
+        u32_t numOfNodes = 0;
+        u32_t numOfEdges = 0;
+        u32_t numOfLabels = 0;
+        double maxLabelShare = 0;       // share of the most frequent label among the edges
+        u32_t numOfCycleNodes = 0;      // nodes in non-trivial SCCs of the cycle-label edges
+        u32_t maxSCCSize = 0;
+        u32_t numOfComponents = 0;      // weakly connected components
+        u32_t maxComponentSize = 0;
+    };
+
+    /// Features of a grammar
+    struct GrammarFeatures
+    {
+        u32_t numOfRules = 0;
+        u32_t numOfTransitiveSymbols = 0;
+        u32_t numOfClosureSymbols = 0;  // Kleene closures that -gopt turns into transitive symbols
+        u32_t numOfVariantSymbols = 0;
+        u32_t numOfUnaryRules = 0;
+    };
+
+protected:
+    GraphFeatures graphFeatures;
+    GrammarFeatures grammarFeatures;
+    SolverTy solver;
+    std::vector<std::string> options;
+    /// names of the options on the command line, e.g., "scc" for -scc or -scc=false
+    Set<std::string> givenOptions;
+    std::string givenSolver;
+
+public:
+    SolverSelector(int argc, char** argv);
+
+    /// Select for a tool, setting the chosen simplification options of CFLOpt
+    //@{
+    SolverTy selectCFL(std::string grammarName, const std::string& graphName);
+    SolverTy selectAA(const std::string& pegName);
+    SolverTy selectVFA(const std::string& vfgName);
+    //@}
+
+    void printDecision();
+
+protected:
+    void readGraphFeatures(const std::string& fname, const std::string& cycleLabel);
+    void readGrammarFeatures(std::string grammarName);
+    void selectSolver(SolverTy ty);
+    void selectOption(const std::string& name, Option<bool>& opt);
+    void selectComponents();
+    void selectSCC();
+
+    inline bool isGiven(const std::string& name) const
+    { return givenOptions.find(name) != givenOptions.end(); }
+};
+
+}
+
+#endif //POCR_SVF_SOLVERSELECTOR_H
@@ -0,0 +1,64 @@
+/* -------------------- StatReport.h ------------------ */
+//
+// Phase timing and JSON statistics shared by the stats of all tools
+//
+
+#ifndef POCR_SVF_STATREPORT_H
+#define POCR_SVF_STATREPORT_H
+
+#include "SVFIR/SVFType.h"
+#include <map>
+#include <string>
+
+namespace SVF
+{
+/*!
+ * Times of the phases of a run, in seconds, and the JSON report of a run.
+ * The report has stable keys and orders: "phases" and "memory" always hold the same fields,
+ * "counters" and "times" hold the statistics printed by the tool, sorted by name.
+ */
+class StatReport
+{
+public:
+    typedef std::map<std::string, u64_t> NUMStatMap;
+    typedef std::map<std::string, double> TIMEStatMap;
+
+    enum Phase
+    {
+        Read = 0,
+        Simplify,
+        InitSolver,
+        Solve,
+        Materialize,
+        NumOfPhases
+    };
+
+    double phaseTimes[NumOfPhases];
+
+    /// Memory usage, in KB
+    u32_t vmrssBefore;
+    u32_t vmrssAfter;
+
+    /// Statistics collected from all printed groups
+    NUMStatMap numStats;
+    TIMEStatMap timeStats;
+
+public:
+    StatReport() : phaseTimes(), vmrssBefore(0), vmrssAfter(0)
+    {}
+
+    static const char* getPhaseName(Phase phase);
+
+    /// Peak resident set size of the process, in KB
+    static u32_t getPeakRSSKB();
+
+    /// Record the phase times into the time statistics, e.g., ReadTime
+    void addPhaseTimes(TIMEStatMap& timeStatMap) const;
+
+    void collect(const NUMStatMap& nums, const TIMEStatMap& times);
+    void writeJSON(const std::string& fName, const std::string& tool) const;
+};
+
+}
+
+#endif //POCR_SVF_STATREPORT_H
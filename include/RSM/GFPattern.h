@@ -85,7 +85,7 @@ class GFPattern : public RSM
 public:
     GFPattern() = default;
 
-    bool subsume(GStateTy s1, GStateTy s2, std::set<Label>& lblSet);  // return true only if s1 is subsumed by s2
+    bool subsume(const GStateTy& s1, const GStateTy& s2, std::set<Label>& lblSet);  // return true only if s1 is subsumed by s2
     std::set<GStateTy> getTgtStatesOfLabels(std::set<Label>& lblSet);                  // get target states of a label
 
     bool isFoldable(NPPattern pattern);
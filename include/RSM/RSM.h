@@ -37,6 +37,8 @@ protected:
     std::map<u32_t, std::string> intToStateMap;
     /// transition rules
     std::map<BoxedStateTy, std::map<char, BoxedStateTy>> transRules;
+    /// compiled transition rules: transTable[flatSrc * (numOfLabels + 1) + lbl] is the flat dst, 0 if no rule
+    std::vector<u32_t> transTable;
     /// initial and accepting states
     GStateTy initState;
     std::set<GStateTy> acptStates;
@@ -102,6 +104,15 @@ public:
         return it->second;
     }
 
+    char getNumOfLabels() const
+    { return numOfLabels; }
+
+    const GStateTy& getInitState() const
+    { return initState; }
+
+    bool isAcptState(const GStateTy& s) const
+    { return acptStates.find(s) != acptStates.end(); }
+
     /// Whether a label/box has an index
 //    static bool hasIdx(const std::string& s)
 //    { return (s.find("_i") == s.size() - 2 && s.find("_i") != -1); }
@@ -120,8 +131,35 @@ public:
     void readInitState(const std::string& inStr);
     void readAcptState(const std::string& inStr);
 
-    GStateTy transition(GStateTy& src, Label lbl);
+    /// Compile the transition rules into transTable, after all rules are added
+    void compile();
+
+    /// Flat states: a local state with at most one box, flat = box * (numOfStates + 1) + localState
+    //@{
+    inline u32_t getNumOfFlatStates() const
+    { return (numOfBoxes + 1) * (numOfStates + 1); }
+
+    inline u32_t toFlatState(u32_t box, u32_t state) const
+    { return box * (numOfStates + 1) + state; }
+
+    inline u32_t boxOfFlatState(u32_t flat) const
+    { return flat / (numOfStates + 1); }
+
+    inline u32_t localOfFlatState(u32_t flat) const
+    { return flat % (numOfStates + 1); }
+
+    inline u32_t flatTransition(u32_t flat, char lbl) const
+    { return transTable[flat * (numOfLabels + 1) + lbl]; }
+    //@}
+
+    GStateTy transition(const GStateTy& src, Label lbl) const;
     std::string transition(std::string& src, std::string& lbl);
+    bool sameTransition(const GStateTy& s1, const GStateTy& s2, Label lbl) const;
+
+protected:
+    u32_t step(const GStateTy& src, Label lbl, bool& pop) const;
+
+public:
 
     void printRSM();
 
@@ -18,12 +18,17 @@ class IVFGFold
 private:
     IVFG* lg;
     std::stack<NodePair> foldablePairs;
+    /// original nodes folded into a predecessor, which reach less than their rep
+    NodeBS foldedNodes;
 
 public:
     IVFGFold(IVFG* g) : lg(g)
     {}
 
     void foldGraph();
+
+    inline const NodeBS& getFoldedNodes() const
+    { return foldedNodes; }
 };
 
 }
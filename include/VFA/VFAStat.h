@@ -13,6 +13,7 @@
 
 #include "SVF-LLVM/BasicTypes.h"
 #include "SVFIR/SVFType.h"
+#include "CFLSolver/StatReport.h"
 #include <iostream>
 #include <map>
 #include <string>
@@ -30,8 +31,8 @@ class IVFG;
 class VFAStat
 {
 public:
-    typedef llvm::DenseMap<const char*, u64_t> NUMStatMap;
-    typedef llvm::DenseMap<const char*, double> TIMEStatMap;
+    typedef StatReport::NUMStatMap NUMStatMap;
+    typedef StatReport::TIMEStatMap TIMEStatMap;
 
     /// num counters
     u32_t numOfIteration;
@@ -40,16 +41,23 @@ public:
     u32_t numOfSEdges;
     u32_t numOfNodes;
     u32_t numOfEdges;
+    u32_t numOfECGEdges;
+    u32_t numOfComponents;
+    u32_t numOfPrunedEdges;
 
     /// time counters
     double timeOfSolving;
     double startTime;
     double endTime;
+    double prefilterTime;
     double sccTime;
     double gfTime;
     double interDyckTime;
     double gsTime;
 
+    /// Phase times and the JSON report
+    StatReport report;
+
 private:
     VFAnalysis* ivf;
 
@@ -70,6 +78,9 @@ public:
                              numOfSumEdges(0),
                              numOfNodes(0),
                              numOfEdges(0),
+                             numOfECGEdges(0),
+                             numOfComponents(0),
+                             numOfPrunedEdges(0),
                              timeOfSolving(0)
     {
         startClk();
@@ -93,6 +104,7 @@ public:
 
     virtual void performStat();
     void vfgStat();
+    void writeReport();
     virtual void printStat(std::string str = "");
 };
 
@@ -14,6 +14,7 @@
 #include "IVFGFold.h"
 #include "IVFGInterDyck.h"
 #include "CFLData/ECG.h"
+#include "CFLData/PairIO.h"
 
 namespace SVF
 {
@@ -43,18 +44,26 @@ public:
 protected:
     /// Reanalyze flag
     bool reanalyze;
+    /// Whether the results are materialized
+    bool materialized;
     /// Graph
     IVFG* _graph;
     std::string graphName;
+    /// call and ret edges indexed by callsite, used for matching call A ret
+    IndexedData callData;
+    IndexedData retData;
     /// Graph simplifiation
     SCC* scc;
     IVFGFold* ivfgFold;
     IVFGInterDyck* interDyck;
+    /// Solvers of weakly connected components
+    std::vector<VFAnalysis*> components;
 
 public:
     /// Constructor
-    VFAnalysis(std::string& gName) : reanalyze(false),
-                                     stat(nullptr),
+    VFAnalysis(std::string& gName) : stat(nullptr),
+                                     reanalyze(false),
+                                     materialized(false),
                                      _graph(nullptr),
                                      graphName(gName),
                                      scc(nullptr),
@@ -70,6 +79,8 @@ public:
         delete scc;
         delete ivfgFold;
         delete interDyck;
+        for (VFAnalysis* comp : components)
+            delete comp;
     }
 
     /// Graph operations
@@ -100,6 +111,8 @@ public:
     NodeBS checkAndAddEdges(NodeID src, const NodeBS& dstSet, Label lbl) override;
     NodeBS checkAndAddEdges(const NodeBS& srcSet, NodeID dst, Label lbl) override;
 
+    std::string getSymbolName(CFGSymbTy symb) override;
+
     /// stat
     //@{
     inline void dumpStat()
@@ -109,17 +122,47 @@ public:
     }
 
     virtual void countSumEdges();
+    void countComponentSumEdges();
+    //@}
+
+    /// Result materialization
+    //@{
+    /// Derive the result edges left implicit by the solver
+    virtual void materialize()
+    {}
+
+    /// Materialize the results of the solver or its components once, timed as the materialize phase
+    void materializeResults();
+    //@}
+
+    /// Result pairs
+    //@{
+    /// Collect the value-flow pairs, i.e., the A edges between reps
+    virtual void collectValueFlowPairs(PairMap& pairs);
+    void addValueFlowPairs(CFLData* data, PairMap& pairs);
+    /// Map the pairs between reps onto the original nodes
+    void expandMergedPairs(PairMap& pairs);
+    /// Write the value-flow pairs into -write-spairs and answer -queries over them, if set
+    void outputValueFlowPairs();
+    //@}
+
+    /// Solving weakly connected components independently
+    //@{
+    virtual VFAnalysis* createComponentSolver() = 0;
+    void decompose();
+    void solveComponents();
     //@}
 
     static void timer()
     {
-        sleep(CFLOpt::timeOut);
-        assert(false && "Time out!!");
+        sleep(CFLOpt::deadline());
+        Checkpoint::preempt();
     }
 
     /// Graph simplification
     //@{
     void simplifyGraph();
+    void preFilter();
     void graphFolding();
     void interDyckGS();
     void SCCElimination();
@@ -139,7 +182,11 @@ public:
     StdVFA(std::string gName) : VFAnalysis(gName)
     {}
 
+    VFAnalysis* createComponentSolver() override
+    { return new StdVFA(graphName); }
+
     void initSolver() override;
+    void processCFLItem(CFLItem item) override;
 
     /// CFLItem operations
     //@{
@@ -164,13 +211,22 @@ public:
     PocrVFA(std::string gName) : VFAnalysis(gName)
     {}
 
+    VFAnalysis* createComponentSolver() override
+    { return new PocrVFA(graphName); }
+
     void initSolver() override;
     void solve() override;
 
     void matchCallRet(NodeID u, NodeID v);
     void addCl(NodeID u, u32_t idx, TreeNode* vNode);
 
+    void materialize() override;
     void countSumEdges() override;
+    void collectValueFlowPairs(PairMap& pairs) override;
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -183,20 +239,87 @@ public:
     typedef ECG::ECGNode ECGNode;
 
 protected:
-    ECG ecg;
+    ECG* ecg;
 
 public:
-    FocrVFA(std::string gName) : VFAnalysis(gName)
+    FocrVFA(std::string gName) : VFAnalysis(gName), ecg(nullptr)
     {}
 
+    ~FocrVFA() override
+    { delete ecg; }
+
+    VFAnalysis* createComponentSolver() override
+    { return new FocrVFA(graphName); }
+
     void initSolver() override;
+    virtual void initECG();
     void solve() override;
 
-    void addArc(NodeID src, NodeID dst);
+    virtual void addArc(NodeID src, NodeID dst);
     void matchCallRet(NodeID u, NodeID v);
+    virtual void addCl(NodeID u, u32_t idx, NodeID v);
     void addCl(NodeID u, u32_t idx, ECGNode* vNode);
 
+    void materialize() override;
     void countSumEdges() override;
+    void collectValueFlowPairs(PairMap& pairs) override;
+
+    /// ECG statistics
+    //@{
+    virtual u32_t ecgChecks()
+    { return ecg->checks; }
+
+    virtual u32_t countReachablePairs()
+    { return ecg->countReachablePairs(); }
+
+    virtual u32_t countECGEdges()
+    { return ecg->countECGEdges(); }
+
+    virtual void collectReachablePairs(PairMap& pairs)
+    { ecg->collectReachablePairs(pairs); }
+    //@}
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
+};
+
+
+/*!
+ * Focr VFA with bit set-based ECG
+ */
+class BSFocrVFA : public FocrVFA
+{
+protected:
+    BSECG bsecg;
+
+public:
+    BSFocrVFA(std::string gName) : FocrVFA(gName)
+    {}
+
+    VFAnalysis* createComponentSolver() override
+    { return new BSFocrVFA(graphName); }
+
+    void initECG() override;
+
+    void addArc(NodeID src, NodeID dst) override;
+    void addCl(NodeID u, u32_t idx, NodeID v) override;
+
+    u32_t ecgChecks() override
+    { return bsecg.checks; }
+
+    u32_t countReachablePairs() override
+    { return bsecg.countReachablePairs(); }
+
+    u32_t countECGEdges() override
+    { return bsecg.countECGEdges(); }
+
+    void collectReachablePairs(PairMap& pairs) override
+    { bsecg.collectReachablePairs(pairs); }
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -215,6 +338,9 @@ public:
             _oldData = new CFLData();
     }
 
+    VFAnalysis* createComponentSolver() override
+    { return new GspanVFA(graphName); }
+
     CFLData* oldData()
     {
         return _oldData;
@@ -223,6 +349,11 @@ public:
     void initSolver() override;
     void solve() override;
     void countSumEdges() override;
+    void collectValueFlowPairs(PairMap& pairs) override;
+
+    /// Checkpointing
+    void writeState(Checkpoint& ckpt) override;
+    void readState(Checkpoint& ckpt) override;
 };
 
 
@@ -235,6 +366,9 @@ public:
     GRVFA(std::string gName) : StdVFA(gName)
     {}
 
+    VFAnalysis* createComponentSolver() override
+    { return new GRVFA(graphName); }
+
     Set<Label> binarySumm(Label lty, Label rty) override;
     Set<Label> unarySumm(Label lty) override;
 };
@@ -249,6 +383,9 @@ public:
     GRGspanVFA(std::string gName) : GspanVFA(gName)
     {}
 
+    VFAnalysis* createComponentSolver() override
+    { return new GRGspanVFA(graphName); }
+
     Set<Label> binarySumm(Label lty, Label rty) override;
     Set<Label> unarySumm(Label lty) override;
 };
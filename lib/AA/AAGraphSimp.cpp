@@ -3,6 +3,7 @@
 //
 
 #include "AA/AliasAnalysis.h"
+#include "CFLSolver/ParallelSCC.h"
 
 using namespace SVF;
 
@@ -14,6 +15,10 @@ void AliasAnalysis::simplifyGraph()
     {
         SCCElimination();
     }
+    if (CFLOpt::pe())
+    {
+        pointerEquivalence();
+    }
     if (CFLOpt::gf() || CFLOpt::graphSimp())
     {
         graphFolding();
@@ -44,6 +49,21 @@ void AliasAnalysis::graphFolding()
 }
 
 
+void AliasAnalysis::pointerEquivalence()
+{
+    double startClk = stat->getClk();
+
+    if (!pegEquiv)
+        pegEquiv = new PEGEquiv(_graph);
+
+    pegEquiv->mergeEquivalentNodes();
+    stat->numOfPENodes = pegEquiv->getNumOfMergedNodes();
+
+    double endClk = stat->getClk();
+    stat->peTime = (endClk - startClk) / TIMEINTERVAL;
+}
+
+
 void AliasAnalysis::interDyckGS()
 {
     double startClk = stat->getClk();
@@ -67,9 +87,18 @@ void AliasAnalysis::SCCElimination()
 {
     double startClk = stat->getClk();
 
-    if (!scc)
-        scc = new SCC(_graph);
-    SCCDetect();
+    if (CFLOpt::parallelSCC())
+    {
+        ParallelSCC pscc(_graph);
+        pscc.find();
+        graph()->mergeNodesToReps(pscc.getSCCs());
+    }
+    else
+    {
+        if (!scc)
+            scc = new SCC(_graph);
+        SCCDetect();
+    }
 
     double endClk = stat->getClk();
     stat->sccTime = (endClk - startClk) / TIMEINTERVAL;
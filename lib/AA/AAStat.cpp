@@ -30,6 +30,7 @@ void AAStat::printStat(std::string statname)
     }
 
     std::cout.flush();
+    report.collect(PTNumStatMap, timeStatMap);
     PTNumStatMap.clear();
     timeStatMap.clear();
 }
@@ -48,6 +49,13 @@ void AAStat::pegStat()
     PTNumStatMap["#Nodes"] = numOfNodes;
     PTNumStatMap["#Edges"] = numOfEdges;
     timeStatMap["GraphSimpTime"] = gsTime;
+    if (CFLOpt::scc() || CFLOpt::graphSimp())
+        timeStatMap["SCCTime"] = sccTime;
+    if (CFLOpt::pe())
+    {
+        timeStatMap["PETime"] = peTime;
+        PTNumStatMap["#PENodes"] = numOfPENodes;
+    }
 
     AAStat::printStat("PEG Stats");
 }
@@ -61,17 +69,48 @@ void AAStat::performStat()
         pegStat();
 
     if (!CFLOpt::PStat())
+    {
+        writeReport();
         return;
+    }
 
-    aa->countSumEdges();
+    /// the materialization has its own phase, the counters are read afterwards
+    aa->materializeResults();
+    double startClk = getClk();
+    if (CFLOpt::wcc())
+        aa->countComponentSumEdges();
+    else
+        aa->countSumEdges();
+    double countTime = (getClk() - startClk) / TIMEINTERVAL;
 
     timeStatMap["AnalysisTime"] = timeOfSolving;
+    timeStatMap["CountTime"] = countTime;
     timeStatMap["VmrssInGB"] = (_vmrssUsageAfter - _vmrssUsageBefore) / 1024.0 / 1024.0;
+    timeStatMap["PeakVmrssInGB"] = StatReport::getPeakRSSKB() / 1024.0 / 1024.0;
+    report.addPhaseTimes(timeStatMap);
     PTNumStatMap["#Checks"] = checks;
     PTNumStatMap["#SumEdges"] = numOfSumEdges - numOfEdges;
     PTNumStatMap["#SEdges"] = numOfSEdges;
+    if (CFLOpt::wcc())
+        PTNumStatMap["#Components"] = numOfComponents;
+    if (CFLOpt::pe())
+        PTNumStatMap["#MappedSEdges"] = numOfMappedSEdges;
 
     printStat("CFL-reachability analysis Stats");
+    writeReport();
+}
+
+
+void AAStat::writeReport()
+{
+    if (CFLOpt::statFName().empty())
+        return;
+
+    report.phaseTimes[StatReport::Simplify] = gsTime;
+    report.phaseTimes[StatReport::Solve] = timeOfSolving;
+    report.vmrssBefore = _vmrssUsageBefore;
+    report.vmrssAfter = _vmrssUsageAfter;
+    report.writeJSON(CFLOpt::statFName(), "aa");
 }
 
 
@@ -8,6 +8,8 @@
 #include <sstream>
 #include "Util/CppUtil.h"
 #include "AA/AliasAnalysis.h"
+#include "CFLSolver/BatchQuery.h"
+#include "CFLSolver/CFLComponents.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -15,16 +17,27 @@ using namespace SVFUtil;
 
 void AliasAnalysis::initialize()
 {
+    double readStart = AAStat::getClk();
     setGraph(new PEG());
     graph()->readGraph(graphName);  // read a uni-directed graph
 
     stat = new AAStat(this);
+    stat->report.phaseTimes[StatReport::Read] = (stat->getClk() - readStart) / TIMEINTERVAL;
+    enterPhase(StatReport::Simplify);
     stat->setMemUsageBefore();
 
     /// Graph simplification
     simplifyGraph();
     /// initialize online solver
-    initSolver();
+    if (CFLOpt::profileRules())
+        profile = new DerivationProfile();
+    enterPhase(StatReport::InitSolver);
+    double initStart = stat->getClk();
+    if (CFLOpt::wcc())
+        decompose();
+    else
+        initSolver();
+    stat->report.phaseTimes[StatReport::InitSolver] = (stat->getClk() - initStart) / TIMEINTERVAL;
 }
 
 
@@ -32,7 +45,15 @@ void AliasAnalysis::finalize()
 {
     stat->setMemUsageAfter();
 
+    if (CFLOpt::materialize())
+        materializeResults();
     dumpStat();
+    if (!CFLOpt::sPairsFName().empty() || !CFLOpt::queryFName().empty())
+        outputAliasPairs();
+    for (auto comp : components)
+        if (profile && comp->profile)
+            profile->merge(*comp->profile);
+    dumpProfile();
     if (!CFLOpt::outGraphFName().empty())
         graph()->writeGraph(CFLOpt::outGraphFName());
 }
@@ -49,33 +70,62 @@ bool AliasAnalysis::pushIntoWorklist(NodeID src, NodeID dst, Label ty)
 
 void AliasAnalysis::analyze()
 {
-    initialize();
-
     std::thread th(AliasAnalysis::timer);     // timer thread
+    if (!CFLOpt::checkpointFName().empty())
+        Checkpoint::catchSignals();
+    if (CFLOpt::progressInterval())
+        sampler = new ProgressSampler(CFLOpt::progressInterval(), CFLOpt::progressFName());
+    initialize();
+    std::string ckptKey = graphName + " " + std::to_string(graph()->getTotalNodeNum());
+    Checkpoint::resume(this, ckptKey);
+    enterPhase(StatReport::Solve);
+    publishProgress();
 
     // Start solving
     double propStart = stat->getClk();
 
-    do
+    if (CFLOpt::wcc())
     {
         stat->numOfIteration++;
-        reanalyze = false;
         if (CFLOpt::solveCFL())
-            solve();
-    } while (reanalyze);
+            solveComponents();
+    }
+    else
+    {
+        do
+        {
+            stat->numOfIteration++;
+            reanalyze = false;
+            if (CFLOpt::solveCFL())
+                solve();
+        } while (reanalyze && !Checkpoint::isPreempted());
+    }
 
+    publishProgress();
+    if (Checkpoint::isPreempted())
+        Checkpoint::suspend(this, ckptKey);
     double propEnd = stat->getClk();
     stat->timeOfSolving += (propEnd - propStart) / TIMEINTERVAL;
 
 
     // Finalize the analysis
     finalize();
+    delete sampler;
+    sampler = nullptr;
 
     pthread_cancel(th.native_handle());     // kill timer
     th.join();
 }
 
 
+std::string AliasAnalysis::getSymbolName(CFGSymbTy symb)
+{
+    static const char* symbolNames[] = {"fault", "a", "abar", "d", "dbar", "f_i", "fbar_i",
+                                        "M", "V", "DV", "A", "Abar", "FV_i"};
+    return symb <= FV ? symbolNames[symb] : std::to_string(symb);
+}
+
+
 bool AliasAnalysis::checkAndAddEdge(NodeID src, NodeID dst, Label lbl)
 {
     if (!lbl.first)
@@ -106,18 +156,179 @@ NodeBS AliasAnalysis::checkAndAddEdges(const NodeBS& srcSet, NodeID dst, Label l
 }
 
 
+/*!
+ * Summary edges are counted by the data store on insertion; only the mapped edges of -pe need a scan
+ */
 void AliasAnalysis::countSumEdges()
 {
-    stat->numOfSumEdges = 0;
+    materializeResults();
+
+    stat->numOfSumEdges = cflData()->getNumOfEdges();
+    stat->numOfSEdges += cflData()->getNumOfEdges(V);
+
+    if (CFLOpt::pe())
+    {
+        for (auto& iter : cflData()->getSuccMap())
+        {
+            auto vIt = iter.second.find(Label(V, 0));
+            if (vIt != iter.second.end())
+                stat->numOfMappedSEdges += countMappedEdges(iter.first, vIt->second);
+        }
+    }
+}
+
+
+void AliasAnalysis::materializeResults()
+{
+    if (materialized)
+        return;
+
+    enterPhase(StatReport::Materialize);
+    double startClk = stat->getClk();
+    if (components.empty())
+        materialize();
+    else
+        CFLComponents::runInParallel(components.size(), [this](u32_t i)
+        { components[i]->materializeResults(); });
+    materialized = true;
+    stat->report.phaseTimes[StatReport::Materialize] = (stat->getClk() - startClk) / TIMEINTERVAL;
+}
+
+
+/*!
+ * Number of edges between the original nodes that the edges from src to dsts stand for
+ */
+u32_t AliasAnalysis::countMappedEdges(NodeID src, const NodeBS& dsts) const
+{
+    u32_t numOfDsts = 0;
+    for (NodeID dst : dsts)
+        numOfDsts += graph()->numOfSubNodes(dst);
+    return graph()->numOfSubNodes(src) * numOfDsts;
+}
+
+
+void AliasAnalysis::collectAliasPairs(PairMap& pairs)
+{
+    for (AliasAnalysis* comp : components)
+        comp->collectAliasPairs(pairs);
+    addAliasPairs(cflData(), pairs);
+}
+
+
+void AliasAnalysis::addAliasPairs(CFLData* data, PairMap& pairs)
+{
+    for (auto& iter : data->getSuccMap())
+    {
+        auto vIt = iter.second.find(Label(V, 0));
+        if (vIt != iter.second.end() && !vIt->second.empty())
+            pairs[iter.first] |= vIt->second;
+    }
+}
+
+
+/*!
+ * The pairs are collected between reps, and each rep stands for all the original nodes merged
+ * into it by -scc, -pscc, -pe or graph folding
+ */
+void AliasAnalysis::expandMergedPairs(PairMap& pairs)
+{
+    if (!graph()->hasMergedNodes())
+        return;
+
+    PairMap expanded;
+    for (auto& iter : pairs)
+    {
+        NodeBS dsts;
+        for (NodeID dst : iter.second)
+            dsts |= graph()->subNodeIds(dst);
+        for (NodeID src : graph()->subNodeIds(iter.first))
+            expanded[src] |= dsts;
+    }
+    pairs.swap(expanded);
+}
+
+
+void AliasAnalysis::outputAliasPairs()
+{
+    PairMap pairs;
+    collectAliasPairs(pairs);
+    expandMergedPairs(pairs);
+
+    const std::string& fName = CFLOpt::sPairsFName();
+    if (!fName.empty()
+        && !PairWriter::writePairs(fName, pairs, CFLOpt::binaryPairs() ? PairWriter::Binary : PairWriter::Text))
+        std::cout << "error writing " << fName << std::endl;
+    if (!CFLOpt::queryFName().empty())
+        BatchQuery::answer(pairs, "alias");
+}
+
+
+/*!
+ * Split the simplified graph into weakly connected components, each task of which
+ * gets its own solver, graph copy and data store
+ */
+void AliasAnalysis::decompose()
+{
+    CFLComponents wcc;
+    wcc.decompose(graph(), CFLComponents::numOfThreads() * 4);
+    stat->numOfComponents = wcc.getNumOfComponents();
 
-    for (auto iter1 = cflData()->begin(); iter1 != cflData()->end(); ++iter1)
+    for (auto& nodes : wcc.getTasks())
     {
-        for (auto& iter2 : iter1->second)
+        PEG* subGraph = new PEG();
+        subGraph->copyBuild(*graph(), nodes);
+        if (CFLOpt::pe())
         {
-            stat->numOfSumEdges += iter2.second.count();
-            if (iter2.first.first == V)
-                stat->numOfSEdges += iter2.second.count();
+            for (NodeID id : nodes)
+                subGraph->setSubs(id, graph()->subNodeIds(id));
         }
+
+        AliasAnalysis* comp = createComponentSolver();
+        comp->setGraph(subGraph);
+        comp->stat = new AAStat(comp);
+        if (profile)
+            comp->profile = new DerivationProfile();
+        comp->sampler = sampler;
+        components.push_back(comp);
+    }
+
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    {
+        components[i]->initSolver();
+        components[i]->publishProgress();
+    });
+}
+
+
+void AliasAnalysis::solveComponents()
+{
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    {
+        AliasAnalysis* comp = components[i];
+        do
+        {
+            comp->stat->numOfIteration++;
+            comp->reanalyze = false;
+            comp->solve();
+        } while (comp->reanalyze && !Checkpoint::isPreempted());
+        comp->publishProgress();
+    });
+}
+
+
+void AliasAnalysis::countComponentSumEdges()
+{
+    materializeResults();
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    { components[i]->countSumEdges(); });
+
+    stat->numOfSumEdges = 0;
+    for (AliasAnalysis* comp : components)
+    {
+        stat->checks += comp->stat->checks;
+        stat->numOfSumEdges += comp->stat->numOfSumEdges;
+        stat->numOfSEdges += comp->stat->numOfSEdges;
+        stat->numOfMappedSEdges += comp->stat->numOfMappedSEdges;
     }
 }
 
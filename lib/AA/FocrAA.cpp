@@ -29,22 +29,28 @@ void FocrAA::initSolver()
         {
             cflData()->addEdge(srcId, dstId, Label(f, edge->getEdgeIdx()));
             cflData()->addEdge(dstId, srcId, Label(fbar, edge->getEdgeIdx()));
+            gepData.addEdge(srcId, dstId, edge->getEdgeIdx());
         }
     }
 
     /// init ecg
+    initECG();
     for (auto it = graph()->begin(); it != graph()->end(); ++it)
-    {
-        NodeID nId = it->first;
-        ecg.addNode(nId);
-        setV(nId, nId);
-    }
+        setV(it->first, it->first);
+}
+
+
+void FocrAA::initECG()
+{
+    ecg = ECG::createECG();
+    for (auto it = graph()->begin(); it != graph()->end(); ++it)
+        ecg->addNode(it->first);
 }
 
 
 void FocrAA::solve()
 {
-    while (!isWorklistEmpty())
+    while (!isWorklistEmpty() && !Checkpoint::isPreempted())
     {
         CFLItem item = popFromWorklist();
         Label type = item.label();
@@ -60,23 +66,29 @@ void FocrAA::solve()
         else if (type.first == M)
         {
             setM(src, dst);
-            addV(ecg.getNode(src), ecg.getNode(dst));
+            addV(src, dst);
         }
         else if (type.first == V)
-            addV(ecg.getNode(src), ecg.getNode(dst));
+            addV(src, dst);
     }
 }
 
 
 void FocrAA::addArc(NodeID src, NodeID dst)
 {
-    if (ecg.isReachable(src, dst))
+    if (ecg->isReachable(src, dst))
         return;
 
-    if (ecg.isReachable(dst, src))   // src --> dst is a back edge
-        ecg.insertBackEdge(src, dst);
+    if (ecg->isReachable(dst, src))   // src --> dst is a back edge
+        ecg->insertBackEdge(src, dst);
     else                                    // src --> dst is a forward edge
-        ecg.insertForwardEdge(src, dst);
+        ecg->insertForwardEdge(src, dst);
+}
+
+
+void FocrAA::addV(NodeID u, NodeID v)
+{
+    addV(ecg->getNode(u), ecg->getNode(v));
 }
 
 
@@ -147,32 +159,28 @@ void FocrAA::checkdEdges(NodeID src, NodeID dst)
 
 
 /*!
- * Matching parentheses fbar V f
+ * Matching parentheses fbar V f, only the field offsets shared by src and dst are visited
  */
 void FocrAA::checkfEdges(NodeID src, NodeID dst)
 {
-    for (auto& srcIt : cflData()->getSuccs(src))
+    auto matchOffset = [&](u32_t /*offset*/, const NodeBS& srcTgts, const NodeBS& dstTgts)
     {
-        if (srcIt.first.first == f)
-            for (auto& dstIt : cflData()->getSuccs(dst))
+        for (NodeID srcTgt : srcTgts)
+            for (NodeID dstTgt : dstTgts)
             {
-                if (dstIt.first.first == f && srcIt.first.second == dstIt.first.second)
-                    for (NodeID srcTgt : srcIt.second)
-                        for (NodeID dstTgt : dstIt.second)
-                        {
-                            stat->checks++;
-                            pushIntoWorklist(srcTgt, dstTgt, Label(V, 0));
-                        }
+                stat->checks++;
+                pushIntoWorklist(srcTgt, dstTgt, Label(V, 0));
             }
-    }
+    };
+    IndexedData::forEachCommonIdx(gepData.getSuccs(src), gepData.getSuccs(dst), matchOffset);
 }
 
 
-void FocrAA::countSumEdges()
+/*!
+ * DV and FV edges are left implicit while solving
+ */
+void FocrAA::materialize()
 {
-    /// calculate checks
-    stat->checks += ecg.checks;
-
     /// calculate summary edges
     for (auto& it1 : cflData()->getSuccMap())
     {
@@ -195,7 +203,79 @@ void FocrAA::countSumEdges()
                 }
         }
     }
+}
+
+
+void FocrAA::countSumEdges()
+{
+    /// calculate checks
+    stat->checks += ecgChecks();
 
     AliasAnalysis::countSumEdges();
-    stat->numOfSumEdges += ecg.countReachablePairs() * 2;
-}
\ No newline at end of file
+    stat->numOfSumEdges += countReachablePairs() * 2;
+}
+
+
+/* -------------------- BSFocrAA ------------------ */
+
+void BSFocrAA::initECG()
+{
+    for (auto it = graph()->begin(); it != graph()->end(); ++it)
+        bsecg.addNode(it->first);
+}
+
+
+void BSFocrAA::addArc(NodeID src, NodeID dst)
+{
+    if (bsecg.isReachable(src, dst))
+        return;
+
+    if (bsecg.isReachable(dst, src))   // src --> dst is a back edge
+        bsecg.insertBackEdge(src, dst);
+    else                                    // src --> dst is a forward edge
+        bsecg.insertForthEdge(src, dst);
+}
+
+
+void BSFocrAA::addV(NodeID u, NodeID v)
+{
+    if (!setV(u, v))
+        return;
+
+    for (NodeID vSucc : bsecg.getSuccs(v))
+        addV(u, vSucc);
+
+    for (NodeID uSucc : bsecg.getSuccs(u))
+        addV(uSucc, v);
+}
+
+
+void FocrAA::writeState(Checkpoint& ckpt)
+{
+    AliasAnalysis::writeState(ckpt);
+    ckpt.write(*ecg);
+}
+
+
+void FocrAA::readState(Checkpoint& ckpt)
+{
+    AliasAnalysis::readState(ckpt);
+    ckpt.read(*ecg);
+}
+
+
+/*!
+ * The bit set-based ECG replaces the ECG of the base solver
+ */
+void BSFocrAA::writeState(Checkpoint& ckpt)
+{
+    AliasAnalysis::writeState(ckpt);
+    ckpt.write(bsecg);
+}
+
+
+void BSFocrAA::readState(Checkpoint& ckpt)
+{
+    AliasAnalysis::readState(ckpt);
+    ckpt.read(bsecg);
+}
@@ -131,4 +131,29 @@ void GspanAA::countSumEdges()
     {
         oldData()->checkAndAddEdge(it->first, it->first, std::make_pair(A, 0));
     }
-}
\ No newline at end of file
+}
+
+
+void GspanAA::collectAliasPairs(PairMap& pairs)
+{
+    AliasAnalysis::collectAliasPairs(pairs);
+    addAliasPairs(oldData(), pairs);
+}
+
+
+/*!
+ * The facts of the last round are in cflData, all earlier facts in oldData
+ */
+void GspanAA::writeState(Checkpoint& ckpt)
+{
+    StdAA::writeState(ckpt);
+    ckpt.write(*oldData());
+}
+
+
+void GspanAA::readState(Checkpoint& ckpt)
+{
+    StdAA::readState(ckpt);
+    oldData()->clear();
+    ckpt.read(*oldData());
+}
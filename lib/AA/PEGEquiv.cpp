@@ -0,0 +1,64 @@
+/* -------------------- PEGEquiv.cpp ------------------ */
+//
+// Offline pointer equivalence for PEGs
+//
+
+#include "AA/PEGEquiv.h"
+#include <algorithm>
+
+using namespace SVF;
+
+
+void PEGEquiv::mergeEquivalentNodes()
+{
+    while (true)
+    {
+        std::vector<std::pair<NodeID, NodeBS>> groups = detectEquivalence();
+        if (groups.empty())
+            break;
+
+        for (auto& group : groups)
+            numOfMergedNodes += group.second.count() - 1;
+        peg->mergeNodesToReps(groups);
+    }
+}
+
+
+std::vector<std::pair<NodeID, NodeBS>> PEGEquiv::detectEquivalence()
+{
+    std::map<Label, u32_t> labelToGroup;
+    std::vector<std::pair<NodeID, NodeBS>> groups;
+    Label label;
+    for (auto it = peg->begin(), eit = peg->end(); it != eit; ++it)
+    {
+        labelOf(it->second, label);
+        /// nodes without incoming edges carry values of their own
+        if (label.empty())
+            continue;
+
+        auto lIt = labelToGroup.find(label);
+        if (lIt == labelToGroup.end())
+        {
+            labelToGroup.emplace(label, groups.size());
+            groups.emplace_back(it->first, NodeBS());
+            groups.back().second.set(it->first);
+            continue;
+        }
+        auto& group = groups[lIt->second];
+        group.first = std::min(group.first, it->first);     // the smallest id as rep
+        group.second.set(it->first);
+    }
+
+    groups.erase(std::remove_if(groups.begin(), groups.end(), [](const std::pair<NodeID, NodeBS>& group)
+    { return group.second.count() < 2; }), groups.end());
+    return groups;
+}
+
+
+void PEGEquiv::labelOf(CFLNode* node, Label& label) const
+{
+    label.clear();
+    for (auto it = node->InEdgeBegin(), eit = node->InEdgeEnd(); it != eit; ++it)
+        label.emplace_back(peg->repNodeID((*it)->getSrcID()), (*it)->getEdgeKind(), (*it)->getEdgeIdx());
+    std::sort(label.begin(), label.end());
+}
@@ -29,6 +29,7 @@ void PocrAA::initSolver()
         {
             cflData()->addEdge(srcId, dstId, Label(f, edge->getEdgeIdx()));
             cflData()->addEdge(dstId, srcId, Label(fbar, edge->getEdgeIdx()));
+            gepData.addEdge(srcId, dstId, edge->getEdgeIdx());
         }
     }
 
@@ -44,7 +45,7 @@ void PocrAA::initSolver()
 
 void PocrAA::solve()
 {
-    while (!isWorklistEmpty())
+    while (!isWorklistEmpty() && !Checkpoint::isPreempted())
     {
         CFLItem item = popFromWorklist();
         Label type = item.label();
@@ -135,32 +136,28 @@ void PocrAA::checkdEdges(NodeID src, NodeID dst)
 
 
 /*!
- * Matching parentheses fbar V f
+ * Matching parentheses fbar V f, only the field offsets shared by src and dst are visited
  */
 void PocrAA::checkfEdges(NodeID src, NodeID dst)
 {
-    for (auto& srcIt : cflData()->getSuccs(src))
+    auto matchOffset = [&](u32_t /*offset*/, const NodeBS& srcTgts, const NodeBS& dstTgts)
     {
-        if (srcIt.first.first == f)
-            for (auto& dstIt : cflData()->getSuccs(dst))
+        for (NodeID srcTgt : srcTgts)
+            for (NodeID dstTgt : dstTgts)
             {
-                if (dstIt.first.first == f && srcIt.first.second == dstIt.first.second)
-                    for (NodeID srcTgt : srcIt.second)
-                        for (NodeID dstTgt : dstIt.second)
-                        {
-                            stat->checks++;
-                            pushIntoWorklist(srcTgt, dstTgt, Label(V, 0));
-                        }
+                stat->checks++;
+                pushIntoWorklist(srcTgt, dstTgt, Label(V, 0));
             }
-    }
+    };
+    IndexedData::forEachCommonIdx(gepData.getSuccs(src), gepData.getSuccs(dst), matchOffset);
 }
 
 
-void PocrAA::countSumEdges()
+/*!
+ * DV and FV edges are left implicit while solving
+ */
+void PocrAA::materialize()
 {
-    /// calculate checks
-    stat->checks += hybridData.checks;
-
     /// calculate summary edges
     for (auto& it1 : cflData()->getSuccMap())
     {
@@ -183,9 +180,30 @@ void PocrAA::countSumEdges()
                 }
         }
     }
+}
+
+
+void PocrAA::countSumEdges()
+{
+    /// calculate checks
+    stat->checks += hybridData.checks;
 
     AliasAnalysis::countSumEdges();
 
     for (auto& iter : hybridData.indMap)
         stat->numOfSumEdges += iter.second.size() * 2;  // A and Abar
 }
+
+
+void PocrAA::writeState(Checkpoint& ckpt)
+{
+    AliasAnalysis::writeState(ckpt);
+    ckpt.write(hybridData);
+}
+
+
+void PocrAA::readState(Checkpoint& ckpt)
+{
+    AliasAnalysis::readState(ckpt);
+    ckpt.read(hybridData);
+}
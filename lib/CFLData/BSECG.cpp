@@ -7,10 +7,14 @@
 using namespace SVF;
 
 
-void BSECG::insertForthEdge(NodeID i, NodeID j)
+std::unordered_map<NodeID, NodeBS>& BSECG::insertForthEdge(NodeID i, NodeID j)
 {
+    newEdgeMap.clear();
+
     searchBack(i, j);
     addEdge(i, j);
+
+    return newEdgeMap;
 }
 
 
@@ -46,6 +50,8 @@ void BSECG::searchBack(SVF::NodeID i, SVF::NodeID j)
 void BSECG::searchForth(SVF::NodeID i, SVF::NodeID j)
 {
     setReachable(i, j);
+    recordNewEdge(i, j);
+
     for (auto succ : succMap[j])
     {
         if (!isReachable(i, succ))
@@ -54,10 +60,14 @@ void BSECG::searchForth(SVF::NodeID i, SVF::NodeID j)
 }
 
 
-void BSECG::insertBackEdge(SVF::NodeID i, SVF::NodeID j)
+std::unordered_map<NodeID, NodeBS>& BSECG::insertBackEdge(SVF::NodeID i, SVF::NodeID j)
 {
+    newEdgeMap.clear();
+
     searchBackInCycle(i, j);
     addEdge(i, j);
+
+    return newEdgeMap;
 }
 
 
@@ -70,4 +80,34 @@ void BSECG::searchBackInCycle(SVF::NodeID i, SVF::NodeID j)
         if (!isReachable(pred, j))
             searchBackInCycle(pred, j);
     }
-}
\ No newline at end of file
+}
+
+
+u32_t BSECG::countReachablePairs()
+{
+    u32_t retVal = 0;
+    for (auto& iter : reachableMap)
+    {
+        retVal += iter.second.count();
+    }
+    return retVal;
+}
+
+
+void BSECG::collectReachablePairs(std::map<NodeID, NodeBS>& pairs) const
+{
+    for (auto& iter : reachableMap)
+        if (!iter.second.empty())
+            pairs[iter.first] |= iter.second;
+}
+
+
+u32_t BSECG::countECGEdges()
+{
+    u32_t numOfEdges = 0;
+    for (auto& iter : succMap)
+    {
+        numOfEdges += iter.second.count();
+    }
+    return numOfEdges;
+}
@@ -4,6 +4,7 @@
 
 #include "CFLSolver/CFLBase.h"
 #include "CFLData/CFG.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace SVF;
@@ -93,6 +94,17 @@ void CFG::readProduction(std::string& line)
         addSymbol(vec[2]);
         binaryRules[std::make_pair(getSymbolId(vec[1]), getSymbolId(vec[2]))].insert(getSymbolId(vec[0]));
     }
+    else if (vec.size() > 3)
+    {
+        std::vector<CFGSymbTy> rhs;
+        for (u32_t i = 0; i < vec.size(); ++i)
+        {
+            addSymbol(vec[i]);
+            if (i > 0)
+                rhs.push_back(getSymbolId(vec[i]));
+        }
+        longRules.emplace_back(getSymbolId(vec[0]), rhs);
+    }
 }
 
 
@@ -130,6 +142,65 @@ void CFG::detectTransitiveSymbol()
 }
 
 
+/*!
+ * Write the grammar in the input format, e.g., after the long productions are binarized
+ */
+void CFG::writeGrammar(std::string fname)
+{
+    std::ofstream outFile(fname, std::ios::out);
+    if (!outFile.is_open())
+    {
+        std::cout << "error opening " << fname << std::endl;
+        exit(0);
+    }
+
+    /// the rules as lhs followed by rhs, sorted by symbol ids so the output is reproducible
+    std::vector<std::vector<CFGSymbTy>> rules;
+    for (auto lhs : emptyRules)
+        rules.push_back({lhs});
+    for (auto& rule : unaryRules)
+        for (auto lhs : rule.second)
+            rules.push_back({lhs, rule.first});
+    for (auto& rule : binaryRules)
+        for (auto lhs : rule.second)
+            rules.push_back({lhs, rule.first.first, rule.first.second});
+    for (auto& rule : longRules)
+    {
+        rules.push_back({rule.first});
+        rules.back().insert(rules.back().end(), rule.second.begin(), rule.second.end());
+    }
+    std::sort(rules.begin(), rules.end());
+    for (auto& rule : rules)
+    {
+        outFile << getSymbolString(rule[0]);
+        for (u32_t i = 1; i < rule.size(); ++i)
+            outFile << "\t" << getSymbolString(rule[i]);
+        outFile << std::endl;
+    }
+
+    std::pair<std::string, const Set<CFGSymbTy>*> sections[] = {{"Insert:", &insertSymbols},
+                                                               {"Follow:", &followSymbols},
+                                                               {"Count:", &countSymbols}};
+    for (auto& section : sections)
+    {
+        if (section.second->empty())
+            continue;
+        outFile << std::endl << section.first << std::endl;
+        std::vector<CFGSymbTy> symbs(section.second->begin(), section.second->end());
+        std::sort(symbs.begin(), symbs.end());
+        std::string sep;
+        for (auto symb : symbs)
+        {
+            outFile << sep << getSymbolString(symb);
+            sep = ", ";
+        }
+        outFile << std::endl;
+    }
+
+    outFile.close();
+}
+
+
 void CFG::addSymbol(std::string& s)
 {
     if (hasSymbol(s))
@@ -162,6 +233,8 @@ void CFG::printCFGStat()
     for (auto rule : binaryRules)
         numOfRules += rule.second.size();
 
+    numOfRules += longRules.size();
+
     std::cout << "#Symbol = " << numOfSymbols << ":\t";
     for (auto& it : intToSymbMap)
         std::cout << it.second << "->" << it.first << ", ";
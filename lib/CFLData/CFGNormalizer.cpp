@@ -0,0 +1,168 @@
+/* -------------------- CFGNormalizer.cpp ------------------ */
+//
+// Binarization of grammars with long productions
+//
+
+#include "CFLData/CFGNormalizer.h"
+#include <limits>
+
+using namespace SVF;
+
+
+void CFGNormalizer::normalize(const GraphTy* graph)
+{
+    if (grammar->longRules.empty())
+        return;
+
+    estimateSymbolSizes(graph);
+    for (auto& rule : grammar->longRules)
+        binarize(rule.first, rule.second);
+    grammar->longRules.clear();
+
+    grammar->detectTransitiveSymbol();
+}
+
+
+/*!
+ * Terminal sizes are their numbers of edges in the graph, and nonterminal sizes
+ * are iterated over the productions to a fixpoint, bounded by |N|^2
+ */
+void CFGNormalizer::estimateSymbolSizes(const GraphTy* graph)
+{
+    numOfNodes = std::max<double>(1, graph->getTotalNodeNum());
+    double maxSize = numOfNodes * numOfNodes;
+
+    Map<CFGSymbTy, double> termSizes;
+    for (auto it = graph->begin(), eit = graph->end(); it != eit; ++it)
+        for (auto eIt = it->second->OutEdgeBegin(), eEit = it->second->OutEdgeEnd(); eIt != eEit; ++eIt)
+            termSizes[(*eIt)->getEdgeKind()] += 1;
+    symbSizes = termSizes;
+
+    for (u32_t round = 0; round < maxNumOfRounds; ++round)
+    {
+        Map<CFGSymbTy, double> sizes = termSizes;
+        for (CFGSymbTy lhs : grammar->emptyRules)
+            sizes[lhs] += numOfNodes;
+        for (auto& rule : grammar->unaryRules)
+            for (CFGSymbTy lhs : rule.second)
+                sizes[lhs] += symbSizes[rule.first];
+        for (auto& rule : grammar->binaryRules)
+            for (CFGSymbTy lhs : rule.second)
+                sizes[lhs] += symbSizes[rule.first.first] * symbSizes[rule.first.second] / numOfNodes;
+        for (auto& rule : grammar->longRules)
+            sizes[rule.first] += estimateSize(rule.second, 0, rule.second.size() - 1);
+
+        bool changed = false;
+        for (auto& it : sizes)
+        {
+            it.second = std::min(it.second, maxSize);
+            if (std::abs(it.second - symbSizes[it.first]) > 1e-6 * std::max(1.0, it.second))
+                changed = true;
+        }
+        symbSizes = std::move(sizes);
+        if (!changed)
+            break;
+    }
+}
+
+
+double CFGNormalizer::estimateSize(const SymbVec& rhs, u32_t begin, u32_t end)
+{
+    double size = numOfNodes;
+    for (u32_t i = begin; i <= end; ++i)
+        size *= symbSizes[rhs[i]] / numOfNodes;
+    return size;
+}
+
+
+/*!
+ * Choose the split of every span by dynamic programming over the span lengths;
+ * a span costs its expected size unless its symbol is the lhs or exists already
+ */
+void CFGNormalizer::binarize(CFGSymbTy lhs, const SymbVec& rhs)
+{
+    u32_t n = rhs.size();
+    std::vector<std::vector<double>> costs(n, std::vector<double>(n, 0));
+    std::vector<std::vector<u32_t>> splits(n, std::vector<u32_t>(n, 0));
+    for (u32_t len = 2; len <= n; ++len)
+        for (u32_t begin = 0; begin + len <= n; ++begin)
+        {
+            u32_t end = begin + len - 1;
+            std::string name = getSpanName(lhs, rhs, begin, end);
+            if (len < n && grammar->hasSymbol(name))
+                continue;
+
+            double best = std::numeric_limits<double>::max();
+            for (u32_t k = begin; k < end; ++k)
+            {
+                double cost = costs[begin][k] + costs[k + 1][end];
+                if (cost < best)
+                {
+                    best = cost;
+                    splits[begin][end] = k;
+                }
+            }
+            if (len < n)
+                best += estimateSize(rhs, begin, end);
+            costs[begin][end] = best;
+        }
+
+    CFGSymbTy left = buildSpan(lhs, rhs, 0, splits[0][n - 1], splits);
+    CFGSymbTy right = buildSpan(lhs, rhs, splits[0][n - 1] + 1, n - 1, splits);
+    grammar->binaryRules[std::make_pair(left, right)].insert(lhs);
+}
+
+
+CFGSymbTy CFGNormalizer::buildSpan(CFGSymbTy lhs, const SymbVec& rhs, u32_t begin, u32_t end,
+                                   const std::vector<std::vector<u32_t>>& splits)
+{
+    if (begin == end)
+        return rhs[begin];
+
+    std::string name = getSpanName(lhs, rhs, begin, end);
+    if (grammar->hasSymbol(name))
+        return grammar->getSymbolId(name);
+
+    grammar->addSymbol(name);
+    CFGSymbTy symb = grammar->getSymbolId(name);
+    grammar->insertSymbols.insert(symb);
+    symbSizes[symb] = estimateSize(rhs, begin, end);
+    numOfNewSymbols++;
+
+    CFGSymbTy left = buildSpan(lhs, rhs, begin, splits[begin][end], splits);
+    CFGSymbTy right = buildSpan(lhs, rhs, splits[begin][end] + 1, end, splits);
+    grammar->binaryRules[std::make_pair(left, right)].insert(symb);
+    return symb;
+}
+
+
+/*!
+ * Symbol names joined by '.'. All variant symbols of a production share one index, so a span
+ * holding any of them carries the index, and gets the suffix "_i", only if the lhs or a variant
+ * symbol outside the span needs it. A span matching the index inside, e.g., call_i A ret_i of
+ * an invariant lhs, is index-invariant and named in brackets, e.g., "[call_i.A.ret_i]".
+ */
+std::string CFGNormalizer::getSpanName(CFGSymbTy lhs, const SymbVec& rhs, u32_t begin, u32_t end)
+{
+    std::string name;
+    bool hasVariant = false;
+    for (u32_t i = begin; i <= end; ++i)
+    {
+        if (i > begin)
+            name += ".";
+        name += grammar->getSymbolString(rhs[i]);
+        hasVariant |= grammar->isaVariantSymbol(rhs[i]);
+    }
+    if (!hasVariant)
+        return name;
+
+    bool isVariant = grammar->isaVariantSymbol(lhs);
+    for (u32_t i = 0; i < rhs.size() && !isVariant; ++i)
+        isVariant = (i < begin || i > end) && grammar->isaVariantSymbol(rhs[i]);
+
+    if (!isVariant)
+        return "[" + name + "]";
+    if (name.compare(name.size() - 2, 2, "_i") != 0)
+        name += "_i";
+    return name;
+}
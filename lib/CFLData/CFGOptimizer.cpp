@@ -0,0 +1,262 @@
+/* -------------------- CFGOptimizer.cpp ------------------ */
+//
+// Language-preserving rewriting of grammars before solving
+//
+
+#include "CFLData/CFGOptimizer.h"
+#include <tuple>
+
+using namespace SVF;
+
+
+void CFGOptimizer::optimize(const GraphTy* graph)
+{
+    removeUselessRules(graph);
+    discoverTransitiveSymbols();
+    collapseUnaryRules();
+    /// collapsed symbols may derive nothing now
+    removeUselessRules(graph);
+}
+
+
+/*!
+ * Productive symbols label graph edges or derive from productive symbols;
+ * reachable symbols are the count symbols and the rhs of rules with reachable lhs
+ */
+void CFGOptimizer::removeUselessRules(const GraphTy* graph)
+{
+    Set<CFGSymbTy> productive(grammar->emptyRules.begin(), grammar->emptyRules.end());
+    for (auto it = graph->begin(), eit = graph->end(); it != eit; ++it)
+        for (auto eIt = it->second->OutEdgeBegin(), eEit = it->second->OutEdgeEnd(); eIt != eEit; ++eIt)
+            productive.insert((*eIt)->getEdgeKind());
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto& rule : grammar->unaryRules)
+            if (productive.count(rule.first))
+                for (CFGSymbTy lhs : rule.second)
+                    changed |= productive.insert(lhs).second;
+        for (auto& rule : grammar->binaryRules)
+            if (productive.count(rule.first.first) && productive.count(rule.first.second))
+                for (CFGSymbTy lhs : rule.second)
+                    changed |= productive.insert(lhs).second;
+    }
+
+    Set<CFGSymbTy> reachable(grammar->countSymbols.begin(), grammar->countSymbols.end());
+    changed = !reachable.empty();
+    while (changed)
+    {
+        changed = false;
+        for (auto& rule : grammar->unaryRules)
+            for (CFGSymbTy lhs : rule.second)
+                if (reachable.count(lhs))
+                    changed |= reachable.insert(rule.first).second;
+        for (auto& rule : grammar->binaryRules)
+            for (CFGSymbTy lhs : rule.second)
+                if (reachable.count(lhs))
+                {
+                    changed |= reachable.insert(rule.first.first).second;
+                    changed |= reachable.insert(rule.first.second).second;
+                }
+    }
+    auto isUseful = [&](CFGSymbTy lhs)
+    { return grammar->countSymbols.empty() || reachable.count(lhs); };
+
+    for (auto it = grammar->emptyRules.begin(); it != grammar->emptyRules.end();)
+    {
+        if (isUseful(*it))
+            ++it;
+        else
+        {
+            it = grammar->emptyRules.erase(it);
+            numOfRemovedRules++;
+        }
+    }
+
+    std::vector<std::pair<CFGSymbTy, CFGSymbTy>> uselessUnaryRules;
+    for (auto& rule : grammar->unaryRules)
+        for (CFGSymbTy lhs : rule.second)
+            if (!productive.count(rule.first) || !isUseful(lhs))
+                uselessUnaryRules.emplace_back(lhs, rule.first);
+    for (auto& rule : uselessUnaryRules)
+        removeUnaryRule(rule.first, rule.second);
+
+    std::vector<std::tuple<CFGSymbTy, CFGSymbTy, CFGSymbTy>> uselessBinaryRules;
+    for (auto& rule : grammar->binaryRules)
+        for (CFGSymbTy lhs : rule.second)
+            if (!productive.count(rule.first.first) || !productive.count(rule.first.second) || !isUseful(lhs))
+                uselessBinaryRules.emplace_back(lhs, rule.first.first, rule.first.second);
+    for (auto& rule : uselessBinaryRules)
+        removeBinaryRule(std::get<0>(rule), std::get<1>(rule), std::get<2>(rule));
+
+    numOfRemovedRules += uselessUnaryRules.size() + uselessBinaryRules.size();
+}
+
+
+/*!
+ * Let U be the unary atoms of X, and L (R) the atoms of X ::= X Y (X ::= Y X).
+ * X = U+ if L and R are U or empty; X ::= X X may be present, and X must have no other rules.
+ * X* (with X ::= epsilon) is left alone: POCR and FOCR derive wrong facts for a transitive
+ * symbol with an epsilon rule.
+ */
+void CFGOptimizer::discoverTransitiveSymbols()
+{
+    struct Closure
+    {
+        Set<CFGSymbTy> unaryAtoms;
+        Set<CFGSymbTy> leftAtoms;      // X ::= X Y
+        Set<CFGSymbTy> rightAtoms;     // X ::= Y X
+        bool other = false;
+    };
+
+    Map<CFGSymbTy, Closure> closures;
+    for (auto& rule : grammar->unaryRules)
+        for (CFGSymbTy lhs : rule.second)
+            if (lhs != rule.first)
+                closures[lhs].unaryAtoms.insert(rule.first);
+    for (auto& rule : grammar->binaryRules)
+        for (CFGSymbTy lhs : rule.second)
+        {
+            Closure& closure = closures[lhs];
+            if (rule.first.first == lhs && rule.first.second == lhs)
+                continue;
+            else if (rule.first.first == lhs)
+                closure.leftAtoms.insert(rule.first.second);
+            else if (rule.first.second == lhs)
+                closure.rightAtoms.insert(rule.first.first);
+            else
+                closure.other = true;
+        }
+
+    for (auto& it : closures)
+    {
+        CFGSymbTy lhs = it.first;
+        Closure& closure = it.second;
+        if (closure.other || grammar->isTransitive(lhs) || grammar->isaVariantSymbol(lhs)
+            || grammar->emptyRules.count(lhs))
+            continue;
+        if (closure.leftAtoms.empty() && closure.rightAtoms.empty())
+            continue;
+
+        const Set<CFGSymbTy>& atoms = closure.leftAtoms.empty() ? closure.rightAtoms : closure.leftAtoms;
+        if (!closure.leftAtoms.empty() && !closure.rightAtoms.empty() && closure.leftAtoms != closure.rightAtoms)
+            continue;
+        if (closure.unaryAtoms != atoms)
+            continue;
+
+        for (CFGSymbTy atom : closure.leftAtoms)
+            removeBinaryRule(lhs, lhs, atom);
+        for (CFGSymbTy atom : closure.rightAtoms)
+            removeBinaryRule(lhs, atom, lhs);
+        for (CFGSymbTy atom : atoms)
+            addUnaryRule(lhs, atom);
+        addBinaryRule(lhs, lhs, lhs);
+        grammar->transitiveSymbols.insert(lhs);
+        numOfNewTransitiveSymbols++;
+    }
+}
+
+
+/*!
+ * Collapse X ::= Y: every rule with X on its rhs gets a copy with Y in place of X,
+ * so the X edges copied from Y edges are no longer needed.
+ * A collapsed rule is never added back, which bounds the rewriting.
+ */
+void CFGOptimizer::collapseUnaryRules()
+{
+    Set<std::pair<CFGSymbTy, CFGSymbTy>> collapsed;
+    auto isCollapsible = [&](CFGSymbTy lhs, CFGSymbTy rhs)
+    {
+        return lhs != rhs && !grammar->isCountSymbol(lhs) && !grammar->isTransitive(lhs)
+               && grammar->isaVariantSymbol(lhs) == grammar->isaVariantSymbol(rhs)
+               && !collapsed.count(std::make_pair(lhs, rhs));
+    };
+
+    while (true)
+    {
+        CFGSymbTy x = 0, y = 0;
+        for (auto& rule : grammar->unaryRules)
+        {
+            for (CFGSymbTy lhs : rule.second)
+                if (isCollapsible(lhs, rule.first))
+                {
+                    x = lhs;
+                    y = rule.first;
+                    break;
+                }
+            if (x)
+                break;
+        }
+        if (!x)
+            break;
+
+        collapsed.insert(std::make_pair(x, y));
+        removeUnaryRule(x, y);
+        numOfCollapsedRules++;
+
+        auto uIt = grammar->unaryRules.find(x);
+        if (uIt != grammar->unaryRules.end())
+        {
+            Set<CFGSymbTy> lhsSet = uIt->second;
+            for (CFGSymbTy lhs : lhsSet)
+                if (lhs != y && !collapsed.count(std::make_pair(lhs, y)))
+                    addUnaryRule(lhs, y);
+        }
+
+        std::vector<std::tuple<CFGSymbTy, CFGSymbTy, CFGSymbTy>> newRules;
+        for (auto& rule : grammar->binaryRules)
+        {
+            CFGSymbTy rhs1 = rule.first.first;
+            CFGSymbTy rhs2 = rule.first.second;
+            if (rhs1 != x && rhs2 != x)
+                continue;
+            for (CFGSymbTy lhs : rule.second)
+            {
+                if (rhs1 == x)
+                    newRules.emplace_back(lhs, y, rhs2);
+                if (rhs2 == x)
+                    newRules.emplace_back(lhs, rhs1, y);
+                if (rhs1 == x && rhs2 == x)
+                    newRules.emplace_back(lhs, y, y);
+            }
+        }
+        for (auto& rule : newRules)
+            addBinaryRule(std::get<0>(rule), std::get<1>(rule), std::get<2>(rule));
+    }
+}
+
+
+void CFGOptimizer::addUnaryRule(CFGSymbTy lhs, CFGSymbTy rhs)
+{
+    grammar->unaryRules[rhs].insert(lhs);
+}
+
+
+void CFGOptimizer::addBinaryRule(CFGSymbTy lhs, CFGSymbTy rhs1, CFGSymbTy rhs2)
+{
+    grammar->binaryRules[std::make_pair(rhs1, rhs2)].insert(lhs);
+}
+
+
+void CFGOptimizer::removeUnaryRule(CFGSymbTy lhs, CFGSymbTy rhs)
+{
+    auto it = grammar->unaryRules.find(rhs);
+    if (it == grammar->unaryRules.end())
+        return;
+    it->second.erase(lhs);
+    if (it->second.empty())
+        grammar->unaryRules.erase(it);
+}
+
+
+void CFGOptimizer::removeBinaryRule(CFGSymbTy lhs, CFGSymbTy rhs1, CFGSymbTy rhs2)
+{
+    auto it = grammar->binaryRules.find(std::make_pair(rhs1, rhs2));
+    if (it == grammar->binaryRules.end())
+        return;
+    it->second.erase(lhs);
+    if (it->second.empty())
+        grammar->binaryRules.erase(it);
+}
@@ -64,6 +64,22 @@ void CFLGraph::copyBuild(const CFLGraph& rhs)
 }
 
 
+void CFLGraph::copyBuild(const CFLGraph& rhs, const std::vector<NodeID>& nodes)
+{
+    /// initialize nodes
+    for (NodeID id : nodes)
+        addNode(id);
+
+    /// initialize edges
+    for (NodeID id : nodes)
+    {
+        CFLNode* node = rhs.getGNode(id);
+        for (auto it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it != eit; ++it)
+            addEdge((*it)->getSrcID(), (*it)->getDstID(), (*it)->getEdgeKind(), (*it)->getEdgeIdx());
+    }
+}
+
+
 //@{
 bool CFLGraph::addEdge(NodeID srcId, NodeID dstId, CFLEdge::GEdgeKind k, u32_t idx)
 {
@@ -108,22 +124,18 @@ void CFLGraph::writeGraph(std::string name)
         return;
     }
 
-    std::set<NodeID> srcs;
-
+    /// the nodes are kept ordered by ID
     for (auto nIt = begin(); nIt != end(); ++nIt) {
-        srcs.insert(nIt->first);
-    }
-
-    for (auto src: srcs) {
-        auto node = getNode(src);
+        NodeID src = nIt->first;
+        auto node = nIt->second;
         for (auto edge: node->getOutEdges()) {
             NodeID dst = edge->getDstID();
             char edgeK = edge->getEdgeKind();
             if (grammar->isaVariantSymbol(edgeK))
                 outFile << src << "\t" << dst << "\t" << grammar->getSymbolString(edgeK) << '\t' << edge->getEdgeIdx()
-                        << std::endl;
+                        << '\n';
             else
-                outFile << src << "\t" << dst << "\t" << grammar->getSymbolString(edgeK) << std::endl;
+                outFile << src << "\t" << dst << "\t" << grammar->getSymbolString(edgeK) << '\n';
         }
     }
 
@@ -9,6 +9,14 @@
 using namespace SVF;
 
 
+ECG* ECG::createECG()
+{
+    if (CFLOpt::iterECG())
+        return new IterECG();
+    return new ECG();
+}
+
+
 std::unordered_map<NodeID, NodeBS>& ECG::insertForwardEdge(NodeID i, NodeID j)
 {
     newEdgeMap.clear();
@@ -147,20 +155,158 @@ void ECG::stepInto(ECGNode* vi)
 u32_t ECG::countReachablePairs()
 {
     u32_t retVal = 0;
-    for (auto& iter : reachableMap)
+    for (const NodeBS& reachables : reachableMap)
     {
-        retVal += iter.second.count();
+        retVal += reachables.count();
     }
     return retVal;
 }
 
 
-void ECG::countECGEdges()
+void ECG::collectReachablePairs(std::map<NodeID, NodeBS>& pairs) const
+{
+    for (NodeID id = 0; id < reachableMap.size(); ++id)
+        if (!reachableMap[id].empty())
+            pairs[id] |= reachableMap[id];
+}
+
+
+u32_t ECG::countECGEdges()
 {
     u32_t numOfEdges = 0;
-    for (auto it : idToNodeMap)
+    for (ECGNode* node : idToNodeMap)
+    {
+        if (node)
+            numOfEdges += node->successors.size();
+    }
+    return numOfEdges;
+}
+
+
+/* -------------------- Iterative ECG ------------------ */
+
+void IterECG::searchForward(ECGNode* vi, ECGNode* vj)
+{
+    setReachable(vi->id, vj->id);
+    recordNewEdge(vi->id, vj->id);
+
+    nodeStack.clear();
+    nodeStack.push_back(vj);
+    while (!nodeStack.empty())
+    {
+        ECGNode* v = nodeStack.back();
+        nodeStack.pop_back();
+        for (ECGNode* vSucc : v->successors)
+        {
+            if (!isReachable(vi->id, vSucc->id))
+            {
+                setReachable(vi->id, vSucc->id);
+                recordNewEdge(vi->id, vSucc->id);
+                nodeStack.push_back(vSucc);
+            }
+        }
+    }
+}
+
+
+void IterECG::searchBackward(ECGNode* vi, ECGNode* vj)
+{
+    std::vector<ECGNode*> predStack;
+    std::vector<ECGEdge> edgesToRemove;
+    predStack.push_back(vi);
+    while (!predStack.empty())
+    {
+        ECGNode* v = predStack.back();
+        predStack.pop_back();
+        /// v may have been reached through another predecessor in the meantime
+        if (isReachable(v->id, vj->id))
+            continue;
+
+        /// remove v --> vSucc when vSucc is already reachable from vj
+        edgesToRemove.clear();
+        for (ECGNode* vSucc : v->successors)
+            if (isReachable(vj->id, vSucc->id) && vj->id != vSucc->id)
+                edgesToRemove.push_back(ECGEdge(v, vSucc));
+        for (const ECGEdge& edge : edgesToRemove)
+            removeEdge(edge);
+
+        searchForward(v, vj);
+
+        for (ECGNode* vPred : v->predecessors)
+            if (!isReachable(vPred->id, vj->id))
+                predStack.push_back(vPred);
+    }
+}
+
+
+void IterECG::searchBackwardInCycle(ECGNode* vi, ECGNode* vj)
+{
+    std::vector<ECGNode*> predStack;
+    predStack.push_back(vi);
+    while (!predStack.empty())
     {
-        numOfEdges += it.second->successors.size();
+        ECGNode* v = predStack.back();
+        predStack.pop_back();
+        if (isReachable(v->id, vj->id))
+            continue;
+
+        searchForward(v, vj);
+
+        for (ECGNode* vPred : v->predecessors)
+            if (!isReachable(vPred->id, vj->id))
+                predStack.push_back(vPred);
     }
-    std::cout << "#ECGEdge" << "\t" << numOfEdges << std::endl;
+}
+
+
+/*!
+ * Iterative version of ECG::stepInto, each frame holds the in-cycle successors not yet handled
+ */
+void IterECG::simplifyCycle(ECGNode* vi)
+{
+    epoch++;
+    ECGNode* lastVisited = vi;
+    markVisited(vi);
+
+    std::vector<std::pair<ECGNode*, std::vector<ECGNode*>>> frames;
+    auto enter = [&](ECGNode* v)
+    {
+        std::vector<ECGNode*> succsInCycle;
+        for (ECGNode* vSucc : v->successors)
+            if (isReachable(vSucc->id, v->id))
+                succsInCycle.push_back(vSucc);
+        frames.emplace_back(v, std::move(succsInCycle));
+    };
+    enter(vi);
+
+    while (!frames.empty())
+    {
+        ECGNode* v = frames.back().first;
+        std::vector<ECGNode*>& succsInCycle = frames.back().second;
+        if (succsInCycle.empty())
+        {
+            frames.pop_back();
+            continue;
+        }
+        ECGNode* vj = succsInCycle.back();
+        succsInCycle.pop_back();
+
+        if (isVisited(vj))
+            removeEdge(v, vj);     // remove redundant back edges
+        else
+        {
+            if (lastVisited != v)
+            {
+                /// reset a branch
+                removeEdge(v, vj);
+                addEdge(lastVisited, vj);
+            }
+            lastVisited = vj;
+            markVisited(vj);
+            enter(vj);
+        }
+    }
+
+    if (lastVisited != vi)
+        addEdge(lastVisited, vi);
 }
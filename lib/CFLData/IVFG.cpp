@@ -11,6 +11,7 @@
 #include "Util/SVFUtil.h"
 #include "CFLData/IVFG.h"
 #include <iostream>
+#include <tuple>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -92,6 +93,22 @@ void IVFG::copyBuild(const IVFG& rhs)
 }
 
 
+void IVFG::copyBuild(const IVFG& rhs, const std::vector<NodeID>& nodes)
+{
+    /// initialize nodes
+    for (NodeID id : nodes)
+        addIVFGNode(id);
+
+    /// initialize edges
+    for (NodeID id : nodes)
+    {
+        CFLNode* node = rhs.getGNode(id);
+        for (auto it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it != eit; ++it)
+            addEdge((*it)->getSrcID(), (*it)->getDstID(), (*it)->getEdgeKind(), (*it)->getEdgeIdx());
+    }
+}
+
+
 //@{
 bool IVFG::addEdge(NodeID srcId, NodeID dstId, CFLEdge::GEdgeKind k, u32_t idx)
 {
@@ -229,6 +246,47 @@ void IVFG::mergeNodeToRep(NodeID nodeId, NodeID newRepId)
 }
 
 
+/*!
+ * Merge each group of nodes into its rep at once
+ */
+void IVFG::mergeNodesToReps(const std::vector<std::pair<NodeID, NodeBS>>& groups)
+{
+    /// detach all the edges of the nodes to be merged
+    std::vector<CFLNode*> subNodes;
+    std::set<CFLEdge*> oldEdges;
+    for (auto& group : groups)
+        for (NodeID subId : group.second)
+        {
+            if (subId == group.first)
+                continue;
+            CFLNode* node = getGNode(subId);
+            subNodes.push_back(node);
+            oldEdges.insert(node->InEdgeBegin(), node->InEdgeEnd());
+            oldEdges.insert(node->OutEdgeBegin(), node->OutEdgeEnd());
+        }
+
+    std::vector<std::tuple<NodeID, NodeID, CFLEdge::GEdgeKind, u32_t>> newEdges;
+    newEdges.reserve(oldEdges.size());
+    for (CFLEdge* edge : oldEdges)
+    {
+        newEdges.emplace_back(edge->getSrcID(), edge->getDstID(), edge->getEdgeKind(), edge->getEdgeIdx());
+        removeIVFGEdge(edge);
+    }
+
+    /// set rep and sub relations, and remove the merged nodes
+    for (auto& group : groups)
+        for (NodeID subId : group.second)
+            if (subId != group.first)
+                updateNodeRepAndSubs(subId, group.first);
+    for (CFLNode* node : subNodes)
+        removeIVFGNode(node);
+
+    /// re-add the edges between reps
+    for (auto& edge : newEdges)
+        addEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge), std::get<3>(edge));
+}
+
+
 void IVFG::updateNodeRepAndSubs(NodeID nodeId, NodeID newRepId)
 {
     setRep(nodeId, newRepId);
@@ -257,30 +315,25 @@ void IVFG::writeGraph(std::string name)
         return;
     }
 
-    std::set<NodeID> srcs;
-
+    /// the nodes are kept ordered by ID
     for (auto nIt = begin(); nIt != end(); ++nIt)
     {
-        srcs.insert(nIt->first);
-    }
-
-    for (auto src: srcs)
-    {
-        auto node = getIVFGNode(src);
+        NodeID src = nIt->first;
+        auto node = nIt->second;
         for (auto edge: node->getOutEdgeWithTy(DirectVF))
         {
             NodeID dst = edge->getDstID();
-            outFile << src << "\t" << dst << "\ta" << std::endl;
+            outFile << src << "\t" << dst << "\ta\n";
         }
         for (auto edge: node->getOutEdgeWithTy(CallVF))
         {
             NodeID dst = edge->getDstID();
-            outFile << src << "\t" << dst << "\tcall_i" << "\t" << edge->getEdgeIdx() << std::endl;
+            outFile << src << "\t" << dst << "\tcall_i" << "\t" << edge->getEdgeIdx() << '\n';
         }
         for (auto edge: node->getOutEdgeWithTy(RetVF))
         {
             NodeID dst = edge->getDstID();
-            outFile << src << "\t" << dst << "\tret_i" << "\t" << edge->getEdgeIdx() << std::endl;
+            outFile << src << "\t" << dst << "\tret_i" << "\t" << edge->getEdgeIdx() << '\n';
         }
     }
 
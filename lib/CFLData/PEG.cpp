@@ -11,6 +11,7 @@
 #include "Util/SVFUtil.h"
 #include "CFLData/PEG.h"
 #include <iostream>
+#include <tuple>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -90,6 +91,25 @@ void PEG::copyBuild(const PEG& rhs)
 }
 
 
+/*!
+ * Copy the subgraph induced by nodes, which should be closed under edges (e.g. a weakly connected component)
+ */
+void PEG::copyBuild(const PEG& rhs, const std::vector<NodeID>& nodes)
+{
+    /// initialize nodes
+    for (NodeID id : nodes)
+        addPEGNode(id);
+
+    /// initialize edges
+    for (NodeID id : nodes)
+    {
+        CFLNode* node = rhs.getGNode(id);
+        for (auto it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it != eit; ++it)
+            addEdge((*it)->getSrcID(), (*it)->getDstID(), (*it)->getEdgeKind(), (*it)->getEdgeIdx());
+    }
+}
+
+
 //@{
 bool PEG::addEdge(NodeID srcId, NodeID dstId, CFLEdge::GEdgeKind k, u32_t idx)
 {
@@ -229,6 +249,48 @@ void PEG::mergeNodeToRep(NodeID nodeId, NodeID newRepId)
 }
 
 
+/*!
+ * Bulk merge: each group of nodes is merged into its rep at once,
+ * so that every edge incident to a merged node is re-targeted exactly once
+ */
+void PEG::mergeNodesToReps(const std::vector<std::pair<NodeID, NodeBS>>& groups)
+{
+    /// detach all the edges of the nodes to be merged
+    std::vector<CFLNode*> subNodes;
+    std::set<CFLEdge*> oldEdges;
+    for (auto& group : groups)
+        for (NodeID subId : group.second)
+        {
+            if (subId == group.first)
+                continue;
+            CFLNode* node = getGNode(subId);
+            subNodes.push_back(node);
+            oldEdges.insert(node->InEdgeBegin(), node->InEdgeEnd());
+            oldEdges.insert(node->OutEdgeBegin(), node->OutEdgeEnd());
+        }
+
+    std::vector<std::tuple<NodeID, NodeID, CFLEdge::GEdgeKind, u32_t>> newEdges;
+    newEdges.reserve(oldEdges.size());
+    for (CFLEdge* edge : oldEdges)
+    {
+        newEdges.emplace_back(edge->getSrcID(), edge->getDstID(), edge->getEdgeKind(), edge->getEdgeIdx());
+        removePEGEdge(edge);
+    }
+
+    /// set rep and sub relations, and remove the merged nodes
+    for (auto& group : groups)
+        for (NodeID subId : group.second)
+            if (subId != group.first)
+                updateNodeRepAndSubs(subId, group.first);
+    for (CFLNode* node : subNodes)
+        removePEGNode(node);
+
+    /// re-add the edges between reps
+    for (auto& edge : newEdges)
+        addEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge), std::get<3>(edge));
+}
+
+
 void PEG::updateNodeRepAndSubs(NodeID nodeId, NodeID newRepId)
 {
     setRep(nodeId, newRepId);
@@ -257,33 +319,28 @@ void PEG::writeGraph(std::string name)
         return;
     }
 
-    std::set<NodeID> srcs;
-
+    /// the nodes are kept ordered by ID
     for (auto nIt = begin(); nIt != end(); ++nIt)
     {
-        srcs.insert(nIt->first);
-    }
-
-    for (auto src: srcs)
-    {
-        auto node = getPEGNode(src);
+        NodeID src = nIt->first;
+        auto node = nIt->second;
         for (auto edge: node->getOutEdgeWithTy(Asgn))
         {
             NodeID dst = edge->getDstID();
-            outFile << src << "\t" << dst << "\ta" << std::endl;
-            outFile << dst << "\t" << src << "\tabar" << std::endl;
+            outFile << src << "\t" << dst << "\ta\n";
+            outFile << dst << "\t" << src << "\tabar\n";
         }
         for (auto edge: node->getOutEdgeWithTy(Deref))
         {
             NodeID dst = edge->getDstID();
-            outFile << src << "\t" << dst << "\td" << std::endl;
-            outFile << dst << "\t" << src << "\tdbar" << std::endl;
+            outFile << src << "\t" << dst << "\td\n";
+            outFile << dst << "\t" << src << "\tdbar\n";
         }
         for (auto edge: node->getOutEdgeWithTy(Gep))
         {
             NodeID dst = edge->getDstID();
-            outFile << src << "\t" << dst << "\tf_i" << "\t" << edge->getEdgeIdx() << std::endl;
-            outFile << dst << "\t" << src << "\tfbar_i" << "\t" << edge->getEdgeIdx() << std::endl;
+            outFile << src << "\t" << dst << "\tf_i" << "\t" << edge->getEdgeIdx() << '\n';
+            outFile << dst << "\t" << src << "\tfbar_i" << "\t" << edge->getEdgeIdx() << '\n';
         }
     }
 
@@ -0,0 +1,260 @@
+/* -------------------- PairIO.cpp ------------------ */
+//
+// Bulk export and import of result pairs
+//
+
+#include "CFLData/PairIO.h"
+#include <cstring>
+
+using namespace SVF;
+
+
+/* -------------------- PairWriter ------------------ */
+
+PairWriter::PairWriter(const std::string& fName, Format fmt) : file(fopen(fName.c_str(), "wb")),
+                                                              format(fmt),
+                                                              buffer(bufferSize),
+                                                              used(0),
+                                                              numOfPairs(0),
+                                                              failed(false)
+{
+    if (!file || format != Binary)
+        return;
+
+    /// the header words are little-endian
+    for (u32_t word : {magic, version})
+        for (u32_t i = 0; i < 4; ++i)
+            buffer[used++] = (char) (word >> (8 * i));
+}
+
+
+void PairWriter::write(NodeID src, const NodeBS& dsts)
+{
+    if (!file || dsts.empty())
+        return;
+
+    if (format == Text)
+    {
+        for (NodeID dst : dsts)
+        {
+            reserve(22);
+            putDecimal(src);
+            buffer[used++] = '\t';
+            putDecimal(dst);
+            buffer[used++] = '\n';
+            numOfPairs++;
+        }
+        return;
+    }
+
+    u32_t numOfDsts = dsts.count();
+    reserve(10);
+    putVarint(src);
+    putVarint(numOfDsts);
+    NodeID prev = 0;
+    for (NodeID dst : dsts)
+    {
+        reserve(5);
+        putVarint(dst - prev);
+        prev = dst;
+    }
+    numOfPairs += numOfDsts;
+}
+
+
+void PairWriter::write(const PairMap& pairs)
+{
+    for (auto& it : pairs)
+        write(it.first, it.second);
+}
+
+
+void PairWriter::flush()
+{
+    if (used && fwrite(buffer.data(), 1, used, file) != used)
+        failed = true;
+    used = 0;
+}
+
+
+bool PairWriter::close()
+{
+    if (!file)
+        return false;
+
+    flush();
+    if (fclose(file) != 0)
+        failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+
+bool PairWriter::writePairs(const std::string& fName, const PairMap& pairs, Format fmt)
+{
+    PairWriter writer(fName, fmt);
+    writer.write(pairs);
+    return writer.close();
+}
+
+
+/* -------------------- PairReader ------------------ */
+
+PairReader::PairReader(const std::string& fName) : file(fopen(fName.c_str(), "rb")),
+                                                   format(PairWriter::Text),
+                                                   buffer(bufferSize),
+                                                   pos(0),
+                                                   size(0),
+                                                   valid(true),
+                                                   hasPending(false),
+                                                   pendingSrc(0),
+                                                   pendingDst(0)
+{
+    if (!file || !fill() || size < 8)
+        return;
+
+    u32_t header[2] = {0, 0};
+    for (u32_t w = 0; w < 2; ++w)
+        for (u32_t i = 0; i < 4; ++i)
+            header[w] |= (u32_t) (unsigned char) buffer[4 * w + i] << (8 * i);
+
+    if (header[0] == PairWriter::magic)
+    {
+        format = PairWriter::Binary;
+        valid = header[1] == PairWriter::version;
+        pos = 8;
+    }
+}
+
+
+bool PairReader::getVarint(u32_t& val)
+{
+    val = 0;
+    for (u32_t shift = 0; shift < 35; shift += 7)
+    {
+        if (!fill())
+        {
+            valid &= shift == 0;    // a truncated varint
+            return false;
+        }
+        unsigned char byte = buffer[pos++];
+        val |= (u32_t) (byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    valid = false;
+    return false;
+}
+
+
+/*!
+ * Parse a "src dst" line, the columns separated by blanks, ignoring empty lines and trailing columns
+ */
+bool PairReader::getTextPair(NodeID& src, NodeID& dst)
+{
+    auto skip = [this](const char* chars)
+    {
+        while (fill() && strchr(chars, buffer[pos]))
+            pos++;
+    };
+    auto number = [this](NodeID& val)
+    {
+        if (!fill() || buffer[pos] < '0' || buffer[pos] > '9')
+            return false;
+        val = 0;
+        while (fill() && buffer[pos] >= '0' && buffer[pos] <= '9')
+            val = val * 10 + (buffer[pos++] - '0');
+        return true;
+    };
+
+    skip(" \t\r\n");
+    if (!fill())
+        return false;
+    if (!number(src))
+    {
+        valid = false;
+        return false;
+    }
+    skip(" \t");
+    if (!number(dst))
+    {
+        valid = false;
+        return false;
+    }
+    while (fill() && buffer[pos] != '\n')
+        pos++;
+    return true;
+}
+
+
+bool PairReader::next(NodeID& src, NodeBS& dsts)
+{
+    if (!isValid())
+        return false;
+    dsts.clear();
+
+    if (format == PairWriter::Binary)
+    {
+        u32_t numOfDsts;
+        if (!getVarint(src))
+            return false;
+        if (!getVarint(numOfDsts))
+        {
+            valid = false;
+            return false;
+        }
+        NodeID dst = 0;
+        for (u32_t i = 0; i < numOfDsts; ++i)
+        {
+            u32_t gap;
+            if (!getVarint(gap))
+            {
+                valid = false;
+                return false;
+            }
+            dst += gap;
+            dsts.set(dst);
+        }
+        return true;
+    }
+
+    /// consecutive lines of the same source make up a record
+    NodeID lineSrc, lineDst;
+    if (hasPending)
+    {
+        lineSrc = pendingSrc;
+        lineDst = pendingDst;
+        hasPending = false;
+    }
+    else if (!getTextPair(lineSrc, lineDst))
+        return false;
+
+    src = lineSrc;
+    dsts.set(lineDst);
+    while (getTextPair(lineSrc, lineDst))
+    {
+        if (lineSrc != src)
+        {
+            hasPending = true;
+            pendingSrc = lineSrc;
+            pendingDst = lineDst;
+            break;
+        }
+        dsts.set(lineDst);
+    }
+    return true;
+}
+
+
+u64_t PairReader::readAll(PairMap& pairs)
+{
+    u64_t numOfPairs = 0;
+    NodeID src;
+    NodeBS dsts;
+    while (next(src, dsts))
+    {
+        numOfPairs += dsts.count();
+        pairs[src] |= dsts;
+    }
+    return numOfPairs;
+}
@@ -0,0 +1,215 @@
+/* -------------------- BatchQuery.cpp ------------------ */
+//
+// Batch answering of reachability and alias queries over result pairs
+//
+
+#include "CFLSolver/BatchQuery.h"
+#include "CFLSolver/CFLComponents.h"
+#include "CFLSolver/CFLOpt.h"
+#include <chrono>
+#include <iostream>
+
+using namespace SVF;
+
+
+/* -------------------- PairIndex ------------------ */
+
+void PairIndex::build(const PairMap& pairs)
+{
+    offsets.clear();
+    dsts.clear();
+    if (pairs.empty())
+        return;
+
+    /// pairs are ordered by source and each NodeBS iterates in ascending order, so every slice is sorted
+    offsets.assign((u64_t) pairs.rbegin()->first + 2, 0);
+    for (auto& it : pairs)
+        offsets[it.first + 1] = it.second.count();
+    for (u64_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+    dsts.reserve(offsets.back());
+    for (auto& it : pairs)
+        for (NodeID dst : it.second)
+            dsts.push_back(dst);
+}
+
+
+/* -------------------- BatchQuery ------------------ */
+
+/*!
+ * One "src dst" query a line; empty lines and lines starting with '#' are skipped, trailing columns ignored
+ */
+bool BatchQuery::readQueries(const std::string& fName)
+{
+    FILE* file = fopen(fName.c_str(), "rb");
+    if (!file)
+    {
+        std::cerr << "error opening " << fName << std::endl;
+        return false;
+    }
+    std::string text;
+    char chunk[1 << 16];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        text.append(chunk, n);
+    fclose(file);
+
+    queries.clear();
+    size_t pos = 0;
+    u32_t lineNo = 0;
+    auto number = [&](NodeID& val)
+    {
+        if (pos >= text.size() || text[pos] < '0' || text[pos] > '9')
+            return false;
+        val = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9')
+            val = val * 10 + (text[pos++] - '0');
+        return true;
+    };
+    auto skipBlanks = [&]()
+    {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r'))
+            pos++;
+    };
+
+    while (pos < text.size())
+    {
+        lineNo++;
+        skipBlanks();
+        if (pos < text.size() && text[pos] != '\n' && text[pos] != '#')
+        {
+            NodeID src = 0, dst = 0;
+            bool ok = number(src);
+            skipBlanks();
+            if (!ok || !number(dst))
+            {
+                std::cerr << "error: malformed query at " << fName << ":" << lineNo << std::endl;
+                return false;
+            }
+            queries.emplace_back(src, dst);
+        }
+        while (pos < text.size() && text[pos] != '\n')
+            pos++;
+        pos++;
+    }
+    return true;
+}
+
+
+/*!
+ * The queries are split into chunks of consecutive queries taken by the thread pool
+ */
+void BatchQuery::answerAll()
+{
+    answers.assign(queries.size(), 0);
+    u64_t numOfChunks = std::min((u64_t) CFLComponents::numOfThreads() * 16, (u64_t) queries.size());
+    if (!numOfChunks)
+        return;
+
+    u64_t chunkSize = (queries.size() + numOfChunks - 1) / numOfChunks;
+    std::vector<u64_t> positives(numOfChunks, 0);
+    CFLComponents::runInParallel(numOfChunks, [&](u32_t c)
+    {
+        u64_t numOfHits = 0;
+        u64_t end = std::min((c + 1) * chunkSize, (u64_t) queries.size());
+        for (u64_t i = c * chunkSize; i < end; ++i)
+        {
+            answers[i] = index.contains(queries[i].first, queries[i].second);
+            numOfHits += answers[i];
+        }
+        positives[c] = numOfHits;
+    });
+
+    numOfPositives = 0;
+    for (u64_t hits : positives)
+        numOfPositives += hits;
+}
+
+
+bool BatchQuery::writeAnswers(const std::string& fName) const
+{
+    FILE* file = fopen(fName.c_str(), "wb");
+    if (!file)
+        return false;
+
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    bool ok = true;
+    for (u64_t i = 0; i < queries.size(); ++i)
+    {
+        buffer += std::to_string(queries[i].first);
+        buffer += '\t';
+        buffer += std::to_string(queries[i].second);
+        buffer += answers[i] ? "\t1\n" : "\t0\n";
+        if (buffer.size() > (1 << 20) - 32)
+        {
+            ok &= fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            buffer.clear();
+        }
+    }
+    ok &= fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    ok &= fclose(file) == 0;
+    return ok;
+}
+
+
+bool BatchQuery::answer(const PairMap& pairs, const std::string& relation)
+{
+    auto start = std::chrono::steady_clock::now();
+    BatchQuery batch;
+    batch.index.build(pairs);
+    double indexTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return answer(batch, indexTime, relation);
+}
+
+
+/*!
+ * The index time covers reading the saved pairs
+ */
+bool BatchQuery::answerSaved(const std::string& relation)
+{
+    const std::string& fName = CFLOpt::queryResultFName();
+    auto start = std::chrono::steady_clock::now();
+    PairReader reader(fName);
+    PairMap pairs;
+    reader.readAll(pairs);
+    if (!reader.isValid())
+    {
+        std::cerr << "error: cannot read the result pairs of " << fName << std::endl;
+        return false;
+    }
+
+    BatchQuery batch;
+    batch.index.build(pairs);
+    pairs.clear();
+    double indexTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return answer(batch, indexTime, relation);
+}
+
+
+bool BatchQuery::answer(BatchQuery& batch, double indexTime, const std::string& relation)
+{
+    if (!batch.readQueries(CFLOpt::queryFName()))
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+    batch.answerAll();
+    double queryTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Queries over the " << relation << " pairs\n";
+    std::cout << "#Queries\t" << batch.queries.size() << "\n";
+    std::cout << "#PositiveQueries\t" << batch.numOfPositives << "\n";
+    std::cout << "#IndexedPairs\t" << batch.index.getNumOfPairs() << "\n";
+    std::cout << "QueryIndexTime\t" << indexTime << "\n";
+    std::cout << "QueryTime\t" << queryTime << "\n";
+    std::cout << "QueriesPerSec\t" << (u64_t) (batch.queries.size() / std::max(queryTime, 1e-9)) << std::endl;
+
+    const std::string& outFName = CFLOpt::queryOutFName();
+    if (!outFName.empty() && !batch.writeAnswers(outFName))
+    {
+        std::cerr << "error writing " << outFName << std::endl;
+        return false;
+    }
+    return true;
+}
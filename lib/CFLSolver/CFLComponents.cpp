@@ -0,0 +1,127 @@
+/* -------------------- CFLComponents.cpp ------------------ */
+//
+// Weakly connected components of CFL graphs, solved independently
+//
+
+#include "CFLSolver/CFLComponents.h"
+#include "CFLSolver/CFLOpt.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace SVF;
+
+
+void CFLComponents::decompose(const GraphTy* graph, u32_t numOfTasks)
+{
+    tasks.clear();
+
+    /// union-find over the nodes, with nodes indexed densely
+    Map<NodeID, u32_t> nodeToIdx;
+    NodeVec idxToNode;
+    for (auto it = graph->begin(), eit = graph->end(); it != eit; ++it)
+    {
+        nodeToIdx[it->first] = idxToNode.size();
+        idxToNode.push_back(it->first);
+    }
+
+    std::vector<u32_t> parent(idxToNode.size());
+    std::vector<u32_t> size(idxToNode.size(), 1);
+    for (u32_t i = 0; i < parent.size(); ++i)
+        parent[i] = i;
+
+    auto find = [&](u32_t x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    for (auto it = graph->begin(), eit = graph->end(); it != eit; ++it)
+    {
+        u32_t srcRoot = find(nodeToIdx[it->first]);
+        for (auto eIt = it->second->OutEdgeBegin(), eEit = it->second->OutEdgeEnd(); eIt != eEit; ++eIt)
+        {
+            u32_t dstRoot = find(nodeToIdx[(*eIt)->getDstID()]);
+            if (srcRoot == dstRoot)
+                continue;
+            if (size[srcRoot] < size[dstRoot])
+                std::swap(srcRoot, dstRoot);
+            parent[dstRoot] = srcRoot;
+            size[srcRoot] += size[dstRoot];
+        }
+    }
+
+    /// collect components, largest first
+    Map<u32_t, u32_t> rootToComp;
+    std::vector<NodeVec> components;
+    for (u32_t i = 0; i < idxToNode.size(); ++i)
+    {
+        u32_t root = find(i);
+        auto it = rootToComp.find(root);
+        if (it == rootToComp.end())
+        {
+            it = rootToComp.emplace(root, components.size()).first;
+            components.emplace_back();
+        }
+        components[it->second].push_back(idxToNode[i]);
+    }
+    std::stable_sort(components.begin(), components.end(), [](const NodeVec& lhs, const NodeVec& rhs)
+    { return lhs.size() > rhs.size(); });
+    numOfComponents = components.size();
+
+    /// a component at least as large as the target size forms a task alone,
+    /// smaller ones are packed together until the target size is reached
+    u32_t targetSize = std::max<u32_t>(1, idxToNode.size() / std::max<u32_t>(1, numOfTasks));
+    NodeVec batch;
+    for (NodeVec& comp : components)
+    {
+        if (comp.size() >= targetSize)
+        {
+            tasks.push_back(std::move(comp));
+            continue;
+        }
+        batch.insert(batch.end(), comp.begin(), comp.end());
+        if (batch.size() >= targetSize)
+        {
+            tasks.push_back(std::move(batch));
+            batch.clear();
+        }
+    }
+    if (!batch.empty())
+        tasks.push_back(std::move(batch));
+}
+
+
+u32_t CFLComponents::numOfThreads()
+{
+    if (CFLOpt::numThreads())
+        return CFLOpt::numThreads();
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+/*!
+ * Run jobs 0 .. numOfJobs-1 on the thread pool; jobs are taken in order, so larger tasks should come first
+ */
+void CFLComponents::runInParallel(u32_t numOfJobs, const std::function<void(u32_t)>& job)
+{
+    std::atomic<u32_t> nextJob(0);
+    auto worker = [&]()
+    {
+        for (u32_t i = nextJob++; i < numOfJobs; i = nextJob++)
+            job(i);
+    };
+
+    u32_t numOfWorkers = std::min(numOfThreads(), numOfJobs);
+    std::vector<std::thread> workers;
+    for (u32_t t = 1; t < numOfWorkers; ++t)
+        workers.emplace_back(worker);
+    worker();   // the calling thread works as well
+
+    for (auto& th : workers)
+        th.join();
+}
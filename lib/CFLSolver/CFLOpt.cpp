@@ -4,7 +4,23 @@
 
 namespace SVF
 {
-const u32_t CFLOpt::timeOut = 24 * 3600;     // in second
+const Option<u32_t> CFLOpt::deadline(
+        "deadline",
+        "Stop solving after specified seconds and exit with status 75, writing the checkpoint if -checkpoint is set",
+        24 * 3600
+);
+
+const Option<std::string> CFLOpt::checkpointFName(
+        "checkpoint",
+        "Write the solver state into specified file when the deadline is reached or SIGTERM is received (not with -wcc)",
+        ""
+);
+
+const Option<std::string> CFLOpt::resumeFName(
+        "resume",
+        "Resume solving from specified checkpoint, written by the same solver on the same graph and options",
+        ""
+);
 
 const Option<bool> CFLOpt::PStat(
         "pstat",
@@ -12,6 +28,18 @@ const Option<bool> CFLOpt::PStat(
         true
 );
 
+const Option<std::string> CFLOpt::statFName(
+        "stat-json",
+        "Write the statistics and phase times into specified JSON file",
+        ""
+);
+
+const Option<bool> CFLOpt::materialize(
+        "materialize",
+        "Materialize the results right after solving, even if neither the statistics nor an output needs them",
+        false
+);
+
 const Option<bool> CFLOpt::solveCFL(
         "solve",
         "Perform dynamic CFL-reachability solving",
@@ -30,12 +58,36 @@ const Option<bool> CFLOpt::graphStat(
         true
 );
 
-const Option<bool> CFLOpt::scc(
+Option<bool> CFLOpt::optGrammar(
+        "gopt",
+        "Optimize the grammar before solving",
+        false
+);
+
+const Option<bool> CFLOpt::preFilter(
+        "prefilter",
+        "Prune edges lying on no path of a regular approximation of the grammar",
+        false
+);
+
+Option<bool> CFLOpt::scc(
         "scc",
         "Enable cycle elimination",
         false
 );
 
+const Option<bool> CFLOpt::parallelSCC(
+        "pscc",
+        "Use multi-threaded SCC detection and bulk merging in cycle elimination",
+        false
+);
+
+Option<bool> CFLOpt::pe(
+        "pe",
+        "Merge pointer-equivalent PEG nodes before solving",
+        false
+);
+
 const Option<bool> CFLOpt::gf(
         "gf",
         "Enable graph folding",
@@ -62,7 +114,37 @@ Option<bool> CFLOpt::ucfl(
 
 const Option<std::string> CFLOpt::sPairsFName(
         "write-spairs",
-        "Write S pairs into specified file",
+        "Write the result pairs (S pairs of cfl, alias pairs of aa, value-flow pairs of vf) into specified file",
+        ""
+);
+
+const Option<bool> CFLOpt::binaryPairs(
+        "binary-pairs",
+        "Write the result pairs in the delta-encoded binary format instead of text",
+        false
+);
+
+const Option<std::string> CFLOpt::queryFName(
+        "queries",
+        "Answer the \"src dst\" queries of specified file over the result pairs after solving",
+        ""
+);
+
+const Option<std::string> CFLOpt::queryOutFName(
+        "query-out",
+        "Write the answers of -queries into specified file as \"src dst 0/1\" lines",
+        ""
+);
+
+const Option<std::string> CFLOpt::queryResultFName(
+        "query-result",
+        "Answer -queries over the result pairs saved by -write-spairs into specified file, without solving",
+        ""
+);
+
+const Option<std::string> CFLOpt::outGrammarFName(
+        "write-grammar",
+        "Write the normalized grammar into specified file",
         ""
 );
 
@@ -72,4 +154,46 @@ const Option<bool> CFLOpt::ecgSCC(
         false
 );
 
+const Option<bool> CFLOpt::iterECG(
+        "iter-ecg",
+        "Use the iterative ECG engine in FOCR solvers",
+        false
+);
+
+const Option<std::string> CFLOpt::traceFName(
+        "record-trace",
+        "Record the edge insertions of the solver into specified file, for replaying in microbench (not with -wcc)",
+        ""
+);
+
+const Option<bool> CFLOpt::profileRules(
+        "profile-rules",
+        "Count the derivations of each production and the fan-outs of the items in the standard solvers",
+        false
+);
+
+const Option<u32_t> CFLOpt::progressInterval(
+        "progress",
+        "Print the phase, worklist length, derived facts, rate and RSS every specified seconds (0 for never)",
+        0
+);
+
+const Option<std::string> CFLOpt::progressFName(
+        "progress-file",
+        "Write the progress samples into specified tab-separated file (with -progress)",
+        ""
+);
+
+Option<bool> CFLOpt::wcc(
+        "wcc",
+        "Solve the weakly connected components of the graph independently",
+        false
+);
+
+const Option<u32_t> CFLOpt::numThreads(
+        "threads",
+        "Number of threads for component solving (0 for all hardware threads)",
+        0
+);
+
 } // namespace SVF.
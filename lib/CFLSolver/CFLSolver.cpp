@@ -4,29 +4,117 @@
 //
 
 #include "CFLSolver/CFLSolver.h"
+#include "CFLSolver/BatchQuery.h"
+#include "CFLSolver/CFLComponents.h"
+#include "CFLSolver/RegularFilter.h"
+#include "CFLData/CFGNormalizer.h"
+#include "CFLData/CFGOptimizer.h"
 
 using namespace SVF;
 
 void StdCFL::initialize()
 {
-    _grammar = new CFG();
-    _grammar->parseGrammar(grammarName);
+    double readStart = CFLStat::getClk();
+    readGrammar();
 
     _graph = new CFLGraph(_grammar);
     _graph->readGraph(graphName);
 
     stat = new CFLStat(this);
+    stat->report.phaseTimes[StatReport::Read] = (stat->getClk() - readStart) / TIMEINTERVAL;
+    enterPhase(StatReport::Simplify);
+
+    /// grammar normalization and prefiltering make up the simplification phase
+    double simpStart = stat->getClk();
+    normalizeGrammar();
     stat->setMemUsageBefore();
 
-    initSolver();
+    if (CFLOpt::preFilter())
+        preFilter();
+    stat->gsTime = (stat->getClk() - simpStart) / TIMEINTERVAL;
+
+    if (!CFLOpt::traceFName().empty() && !CFLOpt::wcc())
+        traceFile = new std::ofstream(CFLOpt::traceFName());
+    if (CFLOpt::profileRules())
+        profile = new DerivationProfile();
+    enterPhase(StatReport::InitSolver);
+    double initStart = stat->getClk();
+    if (CFLOpt::wcc())
+        decompose();
+    else
+        initSolver();
+    stat->report.phaseTimes[StatReport::InitSolver] = (stat->getClk() - initStart) / TIMEINTERVAL;
+}
+
+
+void StdCFL::readGrammar()
+{
+    _grammar = new CFG();
+    _grammar->parseGrammar(grammarName);
+}
+
+
+/*!
+ * Binarize the long productions by the label frequencies of the graph, and optimize the grammar if required
+ */
+void StdCFL::normalizeGrammar()
+{
+    CFGNormalizer normalizer(grammar());
+    normalizer.normalize(graph());
+    if (normalizer.getNumOfNewSymbols() && !CFLOpt::optGrammar())
+        grammar()->printCFGStat();
+
+    if (CFLOpt::optGrammar())
+    {
+        CFGOptimizer optimizer(grammar());
+        optimizer.optimize(graph());
+        std::cout << "Grammar optimization: " << optimizer.getNumOfRemovedRules() << " useless rules removed, "
+                  << optimizer.getNumOfNewTransitiveSymbols() << " transitive symbols found, "
+                  << optimizer.getNumOfCollapsedRules() << " unary rules collapsed" << std::endl;
+        grammar()->printCFGStat();
+    }
+
+    if (!CFLOpt::outGrammarFName().empty())
+        grammar()->writeGrammar(CFLOpt::outGrammarFName());
+}
+
+
+/*!
+ * Remove the edges lying on no path of the count symbols
+ */
+void StdCFL::preFilter()
+{
+    double startClk = stat->getClk();
+
+    RegularFilter filter(*grammar());
+    std::vector<CFLEdge*> edges = filter.findIrrelevantEdges(graph());
+    for (CFLEdge* edge : edges)
+        graph()->removeEdge(edge);
+    stat->numOfPrunedEdges = edges.size();
+
+    double endClk = stat->getClk();
+    stat->prefilterTime = (endClk - startClk) / TIMEINTERVAL;
 }
 
 
 void StdCFL::finalize()
 {
     stat->setMemUsageAfter();
+    /// the tools exit without deleting the solver
+    if (traceFile)
+        traceFile->flush();
 
+    if (CFLOpt::materialize() || !CFLOpt::sPairsFName().empty() || !CFLOpt::queryFName().empty())
+        materializeResults();
     dumpStat();
+    if (!CFLOpt::sPairsFName().empty())
+        stat->writeSPairsIntoFile(CFLOpt::sPairsFName());
+    if (!CFLOpt::queryFName().empty())
+        BatchQuery::answer(stat->sEdgeSet, "S");
+    for (auto comp : components)
+        if (profile && comp->profile)
+            profile->merge(*comp->profile);
+    dumpProfile();
     if (!CFLOpt::outGraphFName().empty())
         graph()->writeGraph(CFLOpt::outGraphFName());
 }
@@ -34,25 +122,46 @@ void StdCFL::finalize()
 
 void StdCFL::analyze()
 {
-    initialize();
-
     std::thread th(StdCFL::timer);      // timer thread
+    if (!CFLOpt::checkpointFName().empty())
+        Checkpoint::catchSignals();
+    if (CFLOpt::progressInterval())
+        sampler = new ProgressSampler(CFLOpt::progressInterval(), CFLOpt::progressFName());
+    initialize();
+    std::string ckptKey = grammarName + " " + graphName + " " + std::to_string(graph()->getTotalNodeNum());
+    Checkpoint::resume(this, ckptKey);
+    enterPhase(StatReport::Solve);
+    publishProgress();
 
     /// start solving
     double propStart = stat->getClk();
 
-    do
+    if (CFLOpt::wcc())
     {
         stat->numOfIteration++;
-        reanalyze = false;
         if (CFLOpt::solveCFL())
-            solve();
-    } while (reanalyze);
+            solveComponents();
+    }
+    else
+    {
+        do
+        {
+            stat->numOfIteration++;
+            reanalyze = false;
+            if (CFLOpt::solveCFL())
+                solve();
+        } while (reanalyze && !Checkpoint::isPreempted());
+    }
 
+    publishProgress();
+    if (Checkpoint::isPreempted())
+        Checkpoint::suspend(this, ckptKey);
     double propEnd = stat->getClk();
     stat->timeOfSolving += (propEnd - propStart) / TIMEINTERVAL;
 
     finalize();
+    delete sampler;
+    sampler = nullptr;
 
     pthread_cancel(th.native_handle());     // kill timer
     th.join();
@@ -144,15 +253,42 @@ void StdCFL::dumpStat()
 }
 
 
+/*!
+ * Summary edges are counted by the data store on insertion, and so are the S edges unless
+ * the S pairs have to be materialized
+ */
 void StdCFL::countSumEdges()
 {
     /// calculate summary edges
-    stat->numOfSumEdges = 0;
-    for (auto it1 = cflData()->begin(); it1 != cflData()->end(); ++it1)
-        for (auto& it2 : it1->second)
-            stat->numOfSumEdges += it2.second.count();
+    stat->numOfSumEdges = cflData()->getNumOfEdges();
 
     /// calculate S edges
+    stat->numOfCountEdges = 0;
+    if (materialized || !isCountedOnInsertion())
+    {
+        materializeResults();
+        for (auto& it1 : stat->sEdgeSet)
+            stat->numOfCountEdges += it1.second.count();
+    }
+    else
+    {
+        CFGSymbTy symb = *grammar()->countSymbols.begin();
+        stat->numOfCountEdges = cflData()->getNumOfEdges(symb) - cflData()->getNumOfSelfEdges(symb);
+    }
+}
+
+
+bool StdCFL::isCountedOnInsertion()
+{
+    return grammar()->countSymbols.size() == 1 && !grammar()->isaVariantSymbol(*grammar()->countSymbols.begin());
+}
+
+
+/*!
+ * S pairs are the edges of the count symbols, except the self loops
+ */
+void StdCFL::materialize()
+{
     stat->sEdgeSet.clear();
     for (auto& it1 : cflData()->getSuccMap())
         for (auto& it2 : it1.second)
@@ -161,10 +297,92 @@ void StdCFL::countSumEdges()
 
     for (auto& it : stat->sEdgeSet)
         it.second.reset(it.first);
+}
+
+
+void StdCFL::materializeResults()
+{
+    if (materialized)
+        return;
+
+    enterPhase(StatReport::Materialize);
+    double startClk = stat->getClk();
+    if (components.empty())
+        materialize();
+    else
+    {
+        CFLComponents::runInParallel(components.size(), [this](u32_t i)
+        { components[i]->materializeResults(); });
+
+        /// components share no nodes, so their S pairs are disjoint
+        stat->sEdgeSet.clear();
+        for (StdCFL* comp : components)
+            stat->sEdgeSet.insert(comp->stat->sEdgeSet.begin(), comp->stat->sEdgeSet.end());
+    }
+    materialized = true;
+    stat->report.phaseTimes[StatReport::Materialize] = (stat->getClk() - startClk) / TIMEINTERVAL;
+}
+
+
+/*!
+ * Each component solver works on its own copy of the grammar, since some solvers rewrite the grammar in initSolver
+ */
+void StdCFL::decompose()
+{
+    CFLComponents wcc;
+    wcc.decompose(graph(), CFLComponents::numOfThreads() * 4);
+    stat->numOfComponents = wcc.getNumOfComponents();
 
+    for (auto& nodes : wcc.getTasks())
+    {
+        StdCFL* comp = createComponentSolver();
+        comp->_grammar = new CFG(*grammar());
+        comp->_graph = new CFLGraph(comp->_grammar);
+        comp->_graph->copyBuild(*graph(), nodes);
+        comp->stat = new CFLStat(comp);
+        if (profile)
+            comp->profile = new DerivationProfile();
+        comp->sampler = sampler;
+        components.push_back(comp);
+    }
+
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    {
+        components[i]->initSolver();
+        components[i]->publishProgress();
+    });
+}
+
+
+void StdCFL::solveComponents()
+{
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    {
+        StdCFL* comp = components[i];
+        do
+        {
+            comp->stat->numOfIteration++;
+            comp->reanalyze = false;
+            comp->solve();
+        } while (comp->reanalyze && !Checkpoint::isPreempted());
+        comp->publishProgress();
+    });
+}
+
+
+void StdCFL::countComponentSumEdges()
+{
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    { components[i]->countSumEdges(); });
+
+    stat->numOfSumEdges = 0;
     stat->numOfCountEdges = 0;
-    for (auto& it1 : stat->sEdgeSet)
-        stat->numOfCountEdges += it1.second.count();
+    for (StdCFL* comp : components)
+    {
+        stat->checks += comp->stat->checks;
+        stat->numOfSumEdges += comp->stat->numOfSumEdges;
+        stat->numOfCountEdges += comp->stat->numOfCountEdges;
+    }
 }
 
 
@@ -195,6 +413,8 @@ bool StdCFL::checkAndAddEdge(NodeID src, NodeID dst, Label lbl)
         return true;
     }
     stat->checks++;
+    if (traceFile)
+        recordTrace(src, dst, lbl);
     return cflData()->checkAndAddEdge(src, dst, lbl);
 }
 
@@ -212,6 +432,9 @@ NodeBS StdCFL::checkAndAddEdges(NodeID src, const NodeBS& dstSet, Label lbl)
         return dstSet;
     }
     stat->checks += dstSet.count();
+    if (traceFile)
+        for (NodeID dst : dstSet)
+            recordTrace(src, dst, lbl);
     return cflData()->checkAndAddEdges(src, dstSet, lbl);
 }
 
@@ -229,5 +452,8 @@ NodeBS StdCFL::checkAndAddEdges(const NodeBS& srcSet, NodeID dst, Label lbl)
         return srcSet;
     }
     stat->checks += srcSet.count();
+    if (traceFile)
+        for (NodeID src : srcSet)
+            recordTrace(src, dst, lbl);
     return cflData()->checkAndAddEdges(srcSet, dst, lbl);
 }
@@ -7,6 +7,7 @@
 #include <iomanip>
 #include "CFLSolver/CFLStat.h"
 #include "CFLSolver/CFLSolver.h"
+#include "CFLData/PairIO.h"
 
 using namespace SVF;
 
@@ -31,6 +32,8 @@ void CFLStat::printStat(std::string statname)
     }
 
     std::cout.flush();
+    report.collect(generalNumMap, timeStatMap);
+    report.collect(PTNumStatMap, timeStatMap);
     generalNumMap.clear();
     PTNumStatMap.clear();
     timeStatMap.clear();
@@ -49,6 +52,11 @@ void CFLStat::graphStat()
 
     PTNumStatMap["#Nodes"] = numOfNodes;
     PTNumStatMap["#Edges"] = numOfEdges;
+    if (CFLOpt::preFilter())
+    {
+        timeStatMap["PrefilterTime"] = prefilterTime;
+        PTNumStatMap["#PrunedEdges"] = numOfPrunedEdges;
+    }
 
     CFLStat::printStat("CFLGraph Stats");
 }
@@ -59,18 +67,43 @@ void CFLStat::performStat()
     endClk();
 
     graphStat();
-    cfl->countSumEdges();
+    /// the materialization has its own phase, and is only needed if the S edges are not counted on insertion
+    if (!cfl->isCountedOnInsertion())
+        cfl->materializeResults();
+    double startClk = getClk();
+    if (CFLOpt::wcc())
+        cfl->countComponentSumEdges();
+    else
+        cfl->countSumEdges();
+    double countTime = (getClk() - startClk) / TIMEINTERVAL;
 
     timeStatMap["AnalysisTime"] = timeOfSolving;
+    timeStatMap["CountTime"] = countTime;
+    timeStatMap["SimplifyTime"] = gsTime;
     timeStatMap["VmrssInGB"] = (_vmrssUsageAfter - _vmrssUsageBefore) / 1024.0 / 1024.0;
+    timeStatMap["PeakVmrssInGB"] = StatReport::getPeakRSSKB() / 1024.0 / 1024.0;
+    report.addPhaseTimes(timeStatMap);
     PTNumStatMap["#Checks"] = checks;
     PTNumStatMap["#SumEdges"] = numOfSumEdges - numOfEdges;
     PTNumStatMap["#CountEdges"] = numOfCountEdges;
+    if (CFLOpt::wcc())
+        PTNumStatMap["#Components"] = numOfComponents;
 
     CFLStat::printStat("CFL-reachability analysis Stats");
+    writeReport();
+}
+
+
+void CFLStat::writeReport()
+{
+    if (CFLOpt::statFName().empty())
+        return;
 
-    if (!CFLOpt::sPairsFName().empty())
-        writeSPairsIntoFile(CFLOpt::sPairsFName());
+    report.phaseTimes[StatReport::Simplify] = gsTime;
+    report.phaseTimes[StatReport::Solve] = timeOfSolving;
+    report.vmrssBefore = _vmrssUsageBefore;
+    report.vmrssAfter = _vmrssUsageAfter;
+    report.writeJSON(CFLOpt::statFName(), "cfl");
 }
 
 
@@ -94,18 +127,6 @@ void CFLStat::setMemUsageAfter()
 
 void CFLStat::writeSPairsIntoFile(std::string fName)
 {
-    std::ofstream outFile(fName, std::ios::out);
-    if (!outFile)
-    {
-        std::cout << "error opening file!";
-        return;
-    }
-
-    for (auto& it1 : sEdgeSet)
-    {
-        for (auto it2 : it1.second)
-            outFile << it1.first << '\t' << it2 << std::endl;
-    }
-
-    outFile.close();
+    if (!PairWriter::writePairs(fName, sEdgeSet, CFLOpt::binaryPairs() ? PairWriter::Binary : PairWriter::Text))
+        std::cout << "error writing " << fName << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,415 @@
+/* -------------------- Checkpoint.cpp ------------------ */
+//
+// Cooperative deadline and checkpoint files of the solvers
+//
+
+#include "CFLSolver/Checkpoint.h"
+#include "CFLSolver/CFLBase.h"
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+using namespace SVF;
+
+std::atomic<bool> Checkpoint::preempted(false);
+
+
+static void onSignal(int)
+{
+    Checkpoint::preempt();
+}
+
+
+/*!
+ * The arguments of the run, except the options not affecting the solver state, e.g., "-pocr -scc tests/a.peg".
+ * Resuming requires the same solver, simplifications and input.
+ */
+std::string Checkpoint::getRunKey()
+{
+    static const char* ignoredOpts[] = {"-checkpoint", "-resume", "-deadline", "-progress", "-stat-json", "-pstat"};
+
+    std::ifstream cmdline("/proc/self/cmdline", std::ios::binary);
+    std::string arg, key;
+    bool isProgram = true;
+    while (getline(cmdline, arg, '\0'))
+    {
+        bool ignored = isProgram;
+        for (const char* opt : ignoredOpts)
+            ignored |= arg.compare(0, strlen(opt), opt) == 0;
+        if (!ignored)
+            key += (key.empty() ? "" : " ") + arg;
+        isProgram = false;
+    }
+    return key;
+}
+
+
+void Checkpoint::catchSignals()
+{
+    signal(SIGTERM, onSignal);
+}
+
+
+void Checkpoint::suspend(CFLBase* solver, const std::string& key)
+{
+    std::cout << "Solving preempted by the deadline or SIGTERM" << std::endl;
+    const std::string& fName = CFLOpt::checkpointFName();
+    if (fName.empty())
+        std::cout << "No checkpoint written (-checkpoint is not set)" << std::endl;
+    else if (CFLOpt::wcc())
+        std::cout << "No checkpoint written (not supported with -wcc)" << std::endl;
+    else if (save(solver, fName, key))
+        std::cout << "Checkpoint written into " << fName << std::endl;
+    else
+        std::cout << "Failed writing the checkpoint into " << fName << std::endl;
+    exit(exitCode);
+}
+
+
+void Checkpoint::resume(CFLBase* solver, const std::string& key)
+{
+    const std::string& fName = CFLOpt::resumeFName();
+    if (fName.empty())
+        return;
+
+    if (CFLOpt::wcc())
+    {
+        std::cerr << "error: -resume is not supported with -wcc" << std::endl;
+        exit(1);
+    }
+    if (!restore(solver, fName, key))
+    {
+        std::cerr << "error: " << fName << " is not a checkpoint of this solver and graph" << std::endl;
+        exit(1);
+    }
+    std::cout << "Resumed from " << fName << std::endl;
+}
+
+
+/*!
+ * The checkpoint is written into a temporary file renamed at the end, so a run killed while
+ * writing never leaves a truncated checkpoint behind
+ */
+bool Checkpoint::save(CFLBase* solver, const std::string& fName, const std::string& key)
+{
+    std::string tmpName = fName + ".tmp";
+    Checkpoint ckpt;
+    ckpt.out.open(tmpName, std::ios::binary);
+    if (!ckpt.out.is_open())
+        return false;
+
+    ckpt.write(magic);
+    ckpt.write(version);
+    ckpt.write(getRunKey());
+    ckpt.write(key);
+    solver->writeState(ckpt);
+    ckpt.out.close();
+
+    if (ckpt.out.fail())
+    {
+        std::remove(tmpName.c_str());
+        return false;
+    }
+    return std::rename(tmpName.c_str(), fName.c_str()) == 0;
+}
+
+
+bool Checkpoint::restore(CFLBase* solver, const std::string& fName, const std::string& key)
+{
+    Checkpoint ckpt;
+    ckpt.in.open(fName, std::ios::binary);
+    if (!ckpt.in.is_open())
+        return false;
+
+    if (ckpt.readU32() != magic || ckpt.readU32() != version
+        || ckpt.readString() != getRunKey() || ckpt.readString() != key)
+        return false;
+    solver->readState(ckpt);
+    return ckpt.good();
+}
+
+
+/// ------------------- Writing -----------------------
+
+void Checkpoint::write(u32_t val)
+{
+    out.write(reinterpret_cast<const char*>(&val), sizeof(val));
+}
+
+
+void Checkpoint::write(const std::string& str)
+{
+    write((u32_t) str.size());
+    out.write(str.data(), str.size());
+}
+
+
+void Checkpoint::write(const NodeBS& bs)
+{
+    write((u32_t) bs.count());
+    for (NodeID id : bs)
+        write(id);
+}
+
+
+void Checkpoint::write(CFLData& data)
+{
+    write((u32_t) data.getSuccMap().size());
+    for (auto& srcIt : data.getSuccMap())
+    {
+        write(srcIt.first);
+        write((u32_t) srcIt.second.size());
+        for (auto& lblIt : srcIt.second)
+        {
+            write(lblIt.first.first);
+            write(lblIt.first.second);
+            write(lblIt.second);
+        }
+    }
+}
+
+
+/*!
+ * Items are cycled through the worklist, so its order is kept
+ */
+void Checkpoint::write(FIFOWorkList<CFLItem>& worklist)
+{
+    u32_t size = worklist.size();
+    write(size);
+    for (u32_t i = 0; i < size; ++i)
+    {
+        CFLItem item = worklist.pop();
+        write(item.src());
+        write(item.dst());
+        write(item.label().first);
+        write(item.label().second);
+        write((u32_t) item.isPrimary());
+        worklist.push(item);
+    }
+}
+
+
+/*!
+ * The tree nodes as (root, node) pairs, followed by the tree edges as (root, parent, child) triples
+ */
+void Checkpoint::write(const HybridData& hybridData)
+{
+    u32_t numOfNodes = 0;
+    u32_t numOfEdges = 0;
+    for (auto& indIt : hybridData.indMap)
+        for (auto& slot : indIt.second)
+        {
+            numOfNodes++;
+            for (HybridData::TreeNode* child : slot.second->children)
+            {
+                (void) child;
+                numOfEdges++;
+            }
+        }
+
+    write(numOfNodes);
+    for (auto& indIt : hybridData.indMap)
+        for (auto& slot : indIt.second)
+        {
+            write(slot.first);
+            write(indIt.first);
+        }
+    write(numOfEdges);
+    for (auto& indIt : hybridData.indMap)
+        for (auto& slot : indIt.second)
+            for (HybridData::TreeNode* child : slot.second->children)
+            {
+                write(slot.first);
+                write(indIt.first);
+                write(child->id);
+            }
+}
+
+
+void Checkpoint::write(const ECG& ecg)
+{
+    u32_t numOfNodes = 0;
+    for (ECG::ECGNode* node : ecg.idToNodeMap)
+        if (node)
+            numOfNodes++;
+
+    write(numOfNodes);
+    for (ECG::ECGNode* node : ecg.idToNodeMap)
+        if (node)
+            write(node->id);
+    for (ECG::ECGNode* node : ecg.idToNodeMap)
+    {
+        if (!node)
+            continue;
+        write(node->successors.size());
+        for (ECG::ECGNode* succ : node->successors)
+            write(succ->id);
+    }
+
+    write((u32_t) ecg.reachableMap.size());
+    for (const NodeBS& bs : ecg.reachableMap)
+        write(bs);
+
+    write((u32_t) ecg.nodeToRepMap.size());
+    for (auto& it : ecg.nodeToRepMap)
+    {
+        write(it.first);
+        write(it.second);
+    }
+}
+
+
+void Checkpoint::write(const BSECG& bsecg)
+{
+    write((u32_t) bsecg.succMap.size());
+    for (auto& it : bsecg.succMap)
+    {
+        write(it.first);
+        write(it.second);
+    }
+    write((u32_t) bsecg.reachableMap.size());
+    for (auto& it : bsecg.reachableMap)
+    {
+        write(it.first);
+        write(it.second);
+    }
+}
+
+
+/// ------------------- Reading -----------------------
+
+u32_t Checkpoint::readU32()
+{
+    u32_t val = 0;
+    in.read(reinterpret_cast<char*>(&val), sizeof(val));
+    return val;
+}
+
+
+std::string Checkpoint::readString()
+{
+    u32_t size = readU32();
+    if (!in.good())
+        return "";
+    std::string str(size, '\0');
+    in.read(&str[0], size);
+    return str;
+}
+
+
+void Checkpoint::read(NodeBS& bs)
+{
+    bs.clear();
+    u32_t count = readU32();
+    for (u32_t i = 0; i < count && in.good(); ++i)
+        bs.set(readU32());
+}
+
+
+void Checkpoint::read(CFLData& data)
+{
+    NodeBS bs;
+    u32_t numOfSrcs = readU32();
+    for (u32_t i = 0; i < numOfSrcs && in.good(); ++i)
+    {
+        NodeID src = readU32();
+        u32_t numOfLabels = readU32();
+        for (u32_t j = 0; j < numOfLabels && in.good(); ++j)
+        {
+            CFGSymbTy symb = readU32();
+            u32_t idx = readU32();
+            read(bs);
+            data.addEdges(src, bs, Label(symb, idx));
+        }
+    }
+}
+
+
+void Checkpoint::read(FIFOWorkList<CFLItem>& worklist)
+{
+    worklist.clear();
+    u32_t size = readU32();
+    for (u32_t i = 0; i < size && in.good(); ++i)
+    {
+        NodeID src = readU32();
+        NodeID dst = readU32();
+        CFGSymbTy symb = readU32();
+        u32_t idx = readU32();
+        bool isPrimary = readU32();
+        worklist.push(CFLItem(src, dst, Label(symb, idx), isPrimary));
+    }
+}
+
+
+void Checkpoint::read(HybridData& hybridData)
+{
+    u32_t numOfNodes = readU32();
+    for (u32_t i = 0; i < numOfNodes && in.good(); ++i)
+    {
+        NodeID root = readU32();
+        NodeID id = readU32();
+        hybridData.addInd(root, id);
+    }
+    u32_t numOfEdges = readU32();
+    for (u32_t i = 0; i < numOfEdges && in.good(); ++i)
+    {
+        NodeID root = readU32();
+        NodeID parent = readU32();
+        NodeID child = readU32();
+        hybridData.insertTreeEdge(hybridData.getNode(root, parent), hybridData.getNode(root, child));
+    }
+}
+
+
+void Checkpoint::read(ECG& ecg)
+{
+    u32_t numOfNodes = readU32();
+    std::vector<NodeID> ids;
+    for (u32_t i = 0; i < numOfNodes && in.good(); ++i)
+    {
+        NodeID id = readU32();
+        if (id >= ecg.idToNodeMap.size() || !ecg.idToNodeMap[id])
+            ecg.addNode(id);
+        ids.push_back(id);
+    }
+    for (NodeID id : ids)
+    {
+        u32_t numOfSuccs = readU32();
+        for (u32_t i = 0; i < numOfSuccs && in.good(); ++i)
+            ecg.addEdge(id, readU32());
+    }
+
+    u32_t size = readU32();
+    if (size > ecg.reachableMap.size())
+        ecg.reachableMap.resize(size);
+    for (u32_t id = 0; id < size && in.good(); ++id)
+        read(ecg.reachableMap[id]);
+
+    u32_t numOfReps = readU32();
+    for (u32_t i = 0; i < numOfReps && in.good(); ++i)
+    {
+        NodeID id = readU32();
+        ecg.nodeToRepMap[id] = readU32();
+    }
+}
+
+
+void Checkpoint::read(BSECG& bsecg)
+{
+    NodeBS bs;
+    u32_t numOfSrcs = readU32();
+    for (u32_t i = 0; i < numOfSrcs && in.good(); ++i)
+    {
+        NodeID src = readU32();
+        read(bs);
+        for (NodeID dst : bs)
+            bsecg.addEdge(src, dst);
+    }
+    u32_t numOfNodes = readU32();
+    for (u32_t i = 0; i < numOfNodes && in.good(); ++i)
+    {
+        NodeID id = readU32();
+        read(bsecg.reachableMap[id]);
+    }
+}
@@ -0,0 +1,91 @@
+/* -------------------- DerivationProfile.cpp ------------------ */
+//
+// Per-production derivation counters and fan-out histograms of the standard solvers
+//
+
+#include "CFLSolver/DerivationProfile.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace SVF;
+
+
+void DerivationProfile::merge(const DerivationProfile& rhs)
+{
+    for (auto& it : rhs.productions)
+    {
+        Counters& counters = productions[it.first];
+        counters.attempts += it.second.attempts;
+        counters.newFacts += it.second.newFacts;
+    }
+    for (u32_t ty = 0; ty < 2; ++ty)
+        for (u32_t b = 0; b < numOfBuckets; ++b)
+            fanOuts[ty][b] += rhs.fanOuts[ty][b];
+}
+
+
+/*!
+ * Productions and labels are listed by attempts, most expensive first
+ */
+void DerivationProfile::dump(const SymbolNameFn& symbolName) const
+{
+    auto printRow = [](const std::string& name, const Counters& counters)
+    {
+        u64_t redundant = counters.attempts - counters.newFacts;
+        std::cout << std::left << std::setw(32) << name << std::right
+                  << std::setw(14) << counters.attempts
+                  << std::setw(14) << counters.newFacts
+                  << std::setw(14) << redundant
+                  << std::setw(10) << std::fixed << std::setprecision(1)
+                  << (counters.attempts ? 100.0 * redundant / counters.attempts : 0) << "%"
+                  << std::defaultfloat << "\n";
+    };
+    auto byAttempts = [](const std::pair<std::string, Counters>& lhs, const std::pair<std::string, Counters>& rhs)
+    { return lhs.second.attempts > rhs.second.attempts; };
+
+    std::vector<std::pair<std::string, Counters>> rows;
+    std::map<CFGSymbTy, Counters> labels;
+    for (auto& it : productions)
+    {
+        CFGSymbTy lhs = std::get<0>(it.first);
+        CFGSymbTy rhs2 = std::get<2>(it.first);
+        std::string name = symbolName(lhs) + " ::= " + symbolName(std::get<1>(it.first));
+        if (rhs2)
+            name += " " + symbolName(rhs2);
+        rows.emplace_back(name, it.second);
+
+        labels[lhs].attempts += it.second.attempts;
+        labels[lhs].newFacts += it.second.newFacts;
+    }
+    std::stable_sort(rows.begin(), rows.end(), byAttempts);
+
+    std::cout << "\n" << std::left << std::setw(32) << "Production" << std::right << std::setw(14) << "#Attempts"
+              << std::setw(14) << "#NewFacts" << std::setw(14) << "#Redundant" << std::setw(11) << "Redundancy" << "\n";
+    for (auto& row : rows)
+        printRow(row.first, row.second);
+
+    rows.clear();
+    for (auto& it : labels)
+        rows.emplace_back(symbolName(it.first), it.second);
+    std::stable_sort(rows.begin(), rows.end(), byAttempts);
+
+    std::cout << "\n" << std::left << std::setw(32) << "Label" << std::right << std::setw(14) << "#Attempts"
+              << std::setw(14) << "#NewFacts" << std::setw(14) << "#Redundant" << std::setw(11) << "Redundancy" << "\n";
+    for (auto& row : rows)
+        printRow(row.first, row.second);
+
+    std::cout << "\n" << std::left << std::setw(32) << "Fan-out" << std::right
+              << std::setw(14) << "#SuccSets" << std::setw(14) << "#PredSets" << "\n";
+    u32_t last = 0;
+    for (u32_t b = 0; b < numOfBuckets; ++b)
+        if (fanOuts[Succ][b] || fanOuts[Pred][b])
+            last = b;
+    for (u32_t b = 0; b <= last; ++b)
+    {
+        std::string range = b ? "[" + std::to_string(1ull << (b - 1)) + ", " + std::to_string(1ull << b) + ")" : "0";
+        std::cout << std::left << std::setw(32) << range << std::right
+                  << std::setw(14) << fanOuts[Succ][b] << std::setw(14) << fanOuts[Pred][b] << "\n";
+    }
+    std::cout << std::endl;
+}
@@ -10,9 +10,18 @@ using namespace SVF;
 void FocrCFL::initSolver()
 {
     StdCFL::initSolver();
+    initECGs();
+    /// Remove transitive rules from binary-summarization list
+    for (auto lbl : grammar()->transitiveSymbols)
+        grammar()->binaryRules[std::make_pair(lbl, lbl)].erase(lbl);
+}
+
+
+void FocrCFL::initECGs()
+{
     /// Initialize ECG
     for (auto lbl : grammar()->transitiveSymbols)
-        ecgs[lbl] = new ECG();
+        ecgs[lbl] = ECG::createECG();
     /// Create ECG nodes
     for (auto it = graph()->begin(); it != graph()->end(); ++it)
     {
@@ -22,9 +31,6 @@ void FocrCFL::initSolver()
             ecgs[lbl]->addNode(nId);
         }
     }
-    /// Remove transitive rules from binary-summarization list
-    for (auto lbl : grammar()->transitiveSymbols)
-        grammar()->binaryRules[std::make_pair(lbl, lbl)].erase(lbl);
 }
 
 
@@ -49,8 +55,7 @@ void FocrCFL::processCFLItem(CFLItem item)
             if (newTy == item.label() && grammar()->isTransitive(rty.first))
             {
                 /// X ::= X A
-                ECGNode* dst = ecgs[rty.first]->getNode(item.dst());
-                checkSuccs(newTy, item.src(), dst);
+                checkSuccs(newTy, rty.first, item.src(), item.dst());
             }
             else
             {
@@ -67,8 +72,7 @@ void FocrCFL::processCFLItem(CFLItem item)
             if (newTy == item.label() && grammar()->isTransitive(lty.first))
             {
                 /// X ::= A X
-                ECGNode* src = ecgs[lty.first]->getNode(item.src());
-                checkPreds(newTy, src, item.dst());
+                checkPreds(newTy, lty.first, item.src(), item.dst());
             }
             else
             {
@@ -108,6 +112,18 @@ void FocrCFL::procPrimaryItem(CFLItem item)
 }
 
 
+void FocrCFL::checkPreds(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst)
+{
+    checkPreds(newLbl, ecgs[ecgLbl]->getNode(src), dst);
+}
+
+
+void FocrCFL::checkSuccs(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst)
+{
+    checkSuccs(newLbl, src, ecgs[ecgLbl]->getNode(dst));
+}
+
+
 void FocrCFL::checkPreds(Label newLbl, ECGNode* src, NodeID dst)
 {
     for (auto& pred : src->predecessors)
@@ -149,6 +165,74 @@ void FocrCFL::countSumEdges()
 }
 
 
+/* ------------------- Methods of BSFocrCFL ----------------- */
+
+
+void BSFocrCFL::initECGs()
+{
+    for (auto it = graph()->begin(); it != graph()->end(); ++it)
+        for (auto lbl : grammar()->transitiveSymbols)
+            bsecgs[lbl].addNode(it->first);
+}
+
+
+void BSFocrCFL::procPrimaryItem(CFLItem item)
+{
+    BSECG& bsecg = bsecgs[item.label().first];
+    NodeID src = item.src();
+    NodeID dst = item.dst();
+
+    if (bsecg.isReachable(src, dst))
+        return;
+
+    std::unordered_map<NodeID, NodeBS>* newEdgeMapPtr;
+
+    if (bsecg.isReachable(dst, src))    // src --> dst is a back edge
+        newEdgeMapPtr = &bsecg.insertBackEdge(src, dst);
+    else
+        newEdgeMapPtr = &bsecg.insertForthEdge(src, dst);
+
+    for (auto& it : *newEdgeMapPtr)
+    {
+        cflData()->addEdges(it.first, it.second, item.label());
+        for (auto newDst : it.second)
+            pushIntoWorklist(it.first, newDst, item.label(), false);
+    }
+}
+
+
+void BSFocrCFL::checkPreds(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst)
+{
+    for (auto pred : bsecgs[ecgLbl].getPreds(src))
+        if (checkAndAddEdge(pred, dst, newLbl))
+        {
+            pushIntoWorklist(pred, dst, newLbl);
+            checkPreds(newLbl, ecgLbl, pred, dst);
+        }
+}
+
+
+void BSFocrCFL::checkSuccs(Label newLbl, CFGSymbTy ecgLbl, NodeID src, NodeID dst)
+{
+    for (auto succ : bsecgs[ecgLbl].getSuccs(dst))
+        if (checkAndAddEdge(src, succ, newLbl))
+        {
+            pushIntoWorklist(src, succ, newLbl);
+            checkSuccs(newLbl, ecgLbl, src, succ);
+        }
+}
+
+
+void BSFocrCFL::countSumEdges()
+{
+    /// calculate checks
+    for (auto& it : bsecgs)
+        stat->checks += it.second.checks;
+
+    StdCFL::countSumEdges();
+}
+
+
 /* ------------------- Methods of TRFocrCFL ----------------- */
 
 
@@ -216,13 +300,12 @@ void TRFocrCFL::countSumEdges()
     for (auto it : ecgs)
         stat->checks += it.second->checks;
 
-    /// calculate summary edges
-    stat->numOfSumEdges = 0;
-    for (auto it1 = cflData()->begin(); it1 != cflData()->end(); ++it1)
-        for (auto& it2 : it1->second)
-            stat->numOfSumEdges += it2.second.count();
+    StdCFL::countSumEdges();
+}
 
-    /// calculate S edges
+
+void TRFocrCFL::materialize()
+{
     stat->sEdgeSet.clear();
     for (auto& it1 : cflData()->getSuccMap())
         for (auto& it2 : it1.second)
@@ -236,8 +319,73 @@ void TRFocrCFL::countSumEdges()
 
     for (auto& it : stat->sEdgeSet)
         it.second.reset(it.first);
+}
+
+
+/*!
+ * The ECG of each transitive symbol, keyed by the symbol, and the follow data
+ */
+void FocrCFL::writeState(Checkpoint& ckpt)
+{
+    StdCFL::writeState(ckpt);
+    ckpt.write((u32_t) ecgs.size());
+    for (auto& it : ecgs)
+    {
+        ckpt.write(it.first);
+        ckpt.write(*it.second);
+    }
+    ckpt.write(followData);
+}
 
-    stat->numOfCountEdges = 0;
-    for (auto& it1 : stat->sEdgeSet)
-        stat->numOfCountEdges += it1.second.count();
-}
\ No newline at end of file
+
+void FocrCFL::readState(Checkpoint& ckpt)
+{
+    StdCFL::readState(ckpt);
+    u32_t size = ckpt.readU32();
+    for (u32_t i = 0; i < size && ckpt.good(); ++i)
+    {
+        CFGSymbTy lbl = ckpt.readU32();
+        ckpt.read(*ecgs[lbl]);
+    }
+    followData.clear();
+    ckpt.read(followData);
+}
+
+
+void BSFocrCFL::writeState(Checkpoint& ckpt)
+{
+    FocrCFL::writeState(ckpt);
+    ckpt.write((u32_t) bsecgs.size());
+    for (auto& it : bsecgs)
+    {
+        ckpt.write(it.first);
+        ckpt.write(it.second);
+    }
+}
+
+
+void BSFocrCFL::readState(Checkpoint& ckpt)
+{
+    FocrCFL::readState(ckpt);
+    u32_t size = ckpt.readU32();
+    for (u32_t i = 0; i < size && ckpt.good(); ++i)
+    {
+        CFGSymbTy lbl = ckpt.readU32();
+        ckpt.read(bsecgs[lbl]);
+    }
+}
+
+
+void TRFocrCFL::writeState(Checkpoint& ckpt)
+{
+    FocrCFL::writeState(ckpt);
+    ckpt.write(secondaryData);
+}
+
+
+void TRFocrCFL::readState(Checkpoint& ckpt)
+{
+    FocrCFL::readState(ckpt);
+    secondaryData.clear();
+    ckpt.read(secondaryData);
+}
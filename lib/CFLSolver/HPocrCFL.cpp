@@ -10,13 +10,13 @@ using namespace SVF;
 
 void HPocrCFL::solve()
 {
-    while (!primaryList.empty())
+    while (!primaryList.empty() && !Checkpoint::isPreempted())
     {
         CFLItem item = primaryList.pop();
         procPrimaryItem(item);
     }
 
-    while (!isWorklistEmpty())
+    while (!isWorklistEmpty() && !Checkpoint::isPreempted())
     {
         CFLItem item = popFromWorklist();
         processCFLItem(item);
@@ -35,3 +35,17 @@ bool HPocrCFL::pushIntoWorklist(NodeID src, NodeID dst, Label ty, bool isPrimary
 
     return CFLBase::pushIntoWorklist(item);
 }
+
+
+void HPocrCFL::writeState(Checkpoint& ckpt)
+{
+    PocrCFL::writeState(ckpt);
+    ckpt.write(primaryList);
+}
+
+
+void HPocrCFL::readState(Checkpoint& ckpt)
+{
+    PocrCFL::readState(ckpt);
+    ckpt.read(primaryList);
+}
@@ -0,0 +1,365 @@
+/* -------------------- ParallelSCC.cpp ------------------ */
+//
+// Multi-threaded SCC detection over direct edges
+//
+
+#include "CFLSolver/ParallelSCC.h"
+#include "CFLSolver/CFLComponents.h"
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+
+using namespace SVF;
+
+
+void ParallelSCC::find()
+{
+    buildCSR();
+    std::vector<Task> pending = trim();
+
+    /// workers take tasks until no task is pending and no worker may produce new ones
+    std::mutex taskMutex;
+    std::condition_variable taskCond;
+    u32_t numOfBusy = 0;
+    auto worker = [&]()
+    {
+        std::vector<Task> newTasks;
+        std::unique_lock<std::mutex> lock(taskMutex);
+        while (true)
+        {
+            taskCond.wait(lock, [&]()
+            { return !pending.empty() || numOfBusy == 0; });
+            if (pending.empty())
+                break;
+
+            Task task = std::move(pending.back());
+            pending.pop_back();
+            numOfBusy++;
+            lock.unlock();
+
+            splitTask(task, newTasks);
+
+            lock.lock();
+            numOfBusy--;
+            for (Task& newTask : newTasks)
+                pending.push_back(std::move(newTask));
+            newTasks.clear();
+            taskCond.notify_all();
+        }
+    };
+
+    u32_t numOfWorkers = CFLComponents::numOfThreads();
+    std::vector<std::thread> workers;
+    for (u32_t t = 1; t < numOfWorkers; ++t)
+        workers.emplace_back(worker);
+    worker();
+
+    for (auto& th : workers)
+        th.join();
+
+    std::sort(sccs.begin(), sccs.end(), [](const std::pair<NodeID, NodeBS>& lhs, const std::pair<NodeID, NodeBS>& rhs)
+    { return lhs.first < rhs.first; });
+}
+
+
+void ParallelSCC::buildCSR()
+{
+    Map<NodeID, u32_t> nodeToIdx;
+    for (auto it = graph->begin(), eit = graph->end(); it != eit; ++it)
+    {
+        nodeToIdx[it->first] = idxToNode.size();
+        idxToNode.push_back(it->first);
+    }
+
+    u32_t numOfNodes = idxToNode.size();
+    succOffsets.assign(numOfNodes + 1, 0);
+    predOffsets.assign(numOfNodes + 1, 0);
+    for (u32_t i = 0; i < numOfNodes; ++i)
+        for (CFLEdge* edge : graph->getGNode(idxToNode[i])->getDirectOutEdges())
+        {
+            if (edge->getDstID() == idxToNode[i])
+                continue;
+            succOffsets[i + 1]++;
+            predOffsets[nodeToIdx[edge->getDstID()] + 1]++;
+        }
+    for (u32_t i = 0; i < numOfNodes; ++i)
+    {
+        succOffsets[i + 1] += succOffsets[i];
+        predOffsets[i + 1] += predOffsets[i];
+    }
+
+    succs.resize(succOffsets[numOfNodes]);
+    preds.resize(predOffsets[numOfNodes]);
+    std::vector<u32_t> succPos(succOffsets.begin(), succOffsets.end() - 1);
+    std::vector<u32_t> predPos(predOffsets.begin(), predOffsets.end() - 1);
+    for (u32_t i = 0; i < numOfNodes; ++i)
+        for (CFLEdge* edge : graph->getGNode(idxToNode[i])->getDirectOutEdges())
+        {
+            if (edge->getDstID() == idxToNode[i])
+                continue;
+            u32_t dst = nodeToIdx[edge->getDstID()];
+            succs[succPos[i]++] = dst;
+            preds[predPos[dst]++] = i;
+        }
+
+    colors = std::vector<std::atomic<u32_t>>(numOfNodes);
+    for (auto& color : colors)
+        color.store(0, std::memory_order_relaxed);
+    fwMarks.assign(numOfNodes, 0);
+    bwMarks.assign(numOfNodes, 0);
+    dfsIndex.assign(numOfNodes, 0);
+    dfsLow.assign(numOfNodes, 0);
+    onStack.assign(numOfNodes, 0);
+}
+
+
+/*!
+ * Repeatedly remove nodes without remaining preds or succs (trivial SCCs),
+ * and return the weakly connected parts of the remaining nodes as initial tasks
+ */
+std::vector<ParallelSCC::Task> ParallelSCC::trim()
+{
+    u32_t numOfNodes = idxToNode.size();
+    std::vector<u32_t> inDegs(numOfNodes);
+    std::vector<u32_t> outDegs(numOfNodes);
+    std::vector<u32_t> trimmed;
+    for (u32_t i = 0; i < numOfNodes; ++i)
+    {
+        inDegs[i] = predOffsets[i + 1] - predOffsets[i];
+        outDegs[i] = succOffsets[i + 1] - succOffsets[i];
+        if (!inDegs[i] || !outDegs[i])
+        {
+            colors[i].store(doneColor, std::memory_order_relaxed);
+            trimmed.push_back(i);
+        }
+    }
+    while (!trimmed.empty())
+    {
+        u32_t n = trimmed.back();
+        trimmed.pop_back();
+        for (u32_t i = succOffsets[n]; i < succOffsets[n + 1]; ++i)
+        {
+            u32_t succ = succs[i];
+            if (!owns(doneColor, succ) && --inDegs[succ] == 0)
+            {
+                colors[succ].store(doneColor, std::memory_order_relaxed);
+                trimmed.push_back(succ);
+            }
+        }
+        for (u32_t i = predOffsets[n]; i < predOffsets[n + 1]; ++i)
+        {
+            u32_t pred = preds[i];
+            if (!owns(doneColor, pred) && --outDegs[pred] == 0)
+            {
+                colors[pred].store(doneColor, std::memory_order_relaxed);
+                trimmed.push_back(pred);
+            }
+        }
+    }
+
+    /// union-find over the remaining nodes
+    std::vector<u32_t> parent(numOfNodes);
+    for (u32_t i = 0; i < numOfNodes; ++i)
+        parent[i] = i;
+    auto findRoot = [&](u32_t x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+    for (u32_t n = 0; n < numOfNodes; ++n)
+    {
+        if (owns(doneColor, n))
+            continue;
+        for (u32_t i = succOffsets[n]; i < succOffsets[n + 1]; ++i)
+            if (!owns(doneColor, succs[i]))
+                parent[findRoot(succs[i])] = findRoot(n);
+    }
+
+    std::vector<Task> tasks;
+    Map<u32_t, u32_t> rootToTask;
+    for (u32_t n = 0; n < numOfNodes; ++n)
+    {
+        if (owns(doneColor, n))
+            continue;
+        u32_t root = findRoot(n);
+        auto it = rootToTask.find(root);
+        if (it == rootToTask.end())
+        {
+            it = rootToTask.emplace(root, tasks.size()).first;
+            tasks.push_back(Task{++numOfColors, {}});
+        }
+        tasks[it->second].nodes.push_back(n);
+        colors[n].store(tasks[it->second].color, std::memory_order_relaxed);
+    }
+    return tasks;
+}
+
+
+/*!
+ * The SCC of a pivot is the intersection of its forward and backward closures;
+ * every other SCC lies entirely in FW\SCC, BW\SCC, or the rest
+ */
+void ParallelSCC::splitTask(Task& task, std::vector<Task>& newTasks)
+{
+    if (task.nodes.size() <= tarjanThreshold)
+    {
+        tarjan(task);
+        return;
+    }
+
+    u32_t color = task.color;
+    u32_t pivot = task.nodes[task.nodes.size() / 2];
+    std::vector<u32_t> stack;
+
+    fwMarks[pivot] = color;
+    stack.push_back(pivot);
+    while (!stack.empty())
+    {
+        u32_t n = stack.back();
+        stack.pop_back();
+        for (u32_t i = succOffsets[n]; i < succOffsets[n + 1]; ++i)
+        {
+            u32_t succ = succs[i];
+            if (owns(color, succ) && fwMarks[succ] != color)
+            {
+                fwMarks[succ] = color;
+                stack.push_back(succ);
+            }
+        }
+    }
+
+    bwMarks[pivot] = color;
+    stack.push_back(pivot);
+    while (!stack.empty())
+    {
+        u32_t n = stack.back();
+        stack.pop_back();
+        for (u32_t i = predOffsets[n]; i < predOffsets[n + 1]; ++i)
+        {
+            u32_t pred = preds[i];
+            if (owns(color, pred) && bwMarks[pred] != color)
+            {
+                bwMarks[pred] = color;
+                stack.push_back(pred);
+            }
+        }
+    }
+
+    std::vector<u32_t> sccNodes;
+    Task parts[3];
+    for (u32_t n : task.nodes)
+    {
+        bool fw = fwMarks[n] == color;
+        bool bw = bwMarks[n] == color;
+        if (fw && bw)
+            sccNodes.push_back(n);
+        else if (fw)
+            parts[0].nodes.push_back(n);
+        else if (bw)
+            parts[1].nodes.push_back(n);
+        else
+            parts[2].nodes.push_back(n);
+    }
+    addSCC(sccNodes);
+
+    for (Task& part : parts)
+    {
+        if (part.nodes.empty())
+            continue;
+        part.color = ++numOfColors;
+        for (u32_t n : part.nodes)
+            colors[n].store(part.color, std::memory_order_relaxed);
+        newTasks.push_back(std::move(part));
+    }
+}
+
+
+void ParallelSCC::tarjan(Task& task)
+{
+    const u32_t unvisited = UINT32_MAX;
+    u32_t color = task.color;
+    u32_t counter = 0;
+    for (u32_t n : task.nodes)
+        dfsIndex[n] = unvisited;
+
+    std::vector<u32_t> sccStack;
+    std::vector<std::pair<u32_t, u32_t>> callStack;     // node and its next succ offset
+    auto visit = [&](u32_t n)
+    {
+        dfsIndex[n] = dfsLow[n] = counter++;
+        sccStack.push_back(n);
+        onStack[n] = 1;
+        callStack.emplace_back(n, succOffsets[n]);
+    };
+
+    for (u32_t root : task.nodes)
+    {
+        if (dfsIndex[root] != unvisited)
+            continue;
+
+        visit(root);
+        while (!callStack.empty())
+        {
+            u32_t n = callStack.back().first;
+            u32_t i = callStack.back().second;
+            if (i < succOffsets[n + 1])
+            {
+                callStack.back().second++;
+                u32_t succ = succs[i];
+                if (!owns(color, succ))
+                    continue;
+                if (dfsIndex[succ] == unvisited)
+                    visit(succ);
+                else if (onStack[succ])
+                    dfsLow[n] = std::min(dfsLow[n], dfsIndex[succ]);
+                continue;
+            }
+
+            if (dfsLow[n] == dfsIndex[n])
+            {
+                std::vector<u32_t> sccNodes;
+                u32_t m;
+                do
+                {
+                    m = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[m] = 0;
+                    sccNodes.push_back(m);
+                } while (m != n);
+                addSCC(sccNodes);
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty())
+            {
+                u32_t parent = callStack.back().first;
+                dfsLow[parent] = std::min(dfsLow[parent], dfsLow[n]);
+            }
+        }
+    }
+}
+
+
+void ParallelSCC::addSCC(const std::vector<u32_t>& nodes)
+{
+    for (u32_t n : nodes)
+        colors[n].store(doneColor, std::memory_order_relaxed);
+
+    if (nodes.size() < 2)
+        return;
+
+    NodeBS subNodes;
+    NodeID rep = idxToNode[nodes.front()];
+    for (u32_t n : nodes)
+    {
+        subNodes.set(idxToNode[n]);
+        rep = std::min(rep, idxToNode[n]);
+    }
+
+    std::lock_guard<std::mutex> lock(sccMutex);
+    sccs.emplace_back(rep, std::move(subNodes));
+}
@@ -196,4 +196,37 @@ void PocrCFL::countSumEdges()
         stat->checks += it.second->checks;
 
     StdCFL::countSumEdges();
-}
\ No newline at end of file
+}
+
+
+/*!
+ * The ptrees and strees of each transitive symbol, keyed by the symbol
+ */
+void PocrCFL::writeState(Checkpoint& ckpt)
+{
+    StdCFL::writeState(ckpt);
+    for (TransitiveLblMap* trees : {&ptrees, &strees})
+    {
+        ckpt.write((u32_t) trees->size());
+        for (auto& it : *trees)
+        {
+            ckpt.write((u32_t) it.first);
+            ckpt.write(*it.second);
+        }
+    }
+}
+
+
+void PocrCFL::readState(Checkpoint& ckpt)
+{
+    StdCFL::readState(ckpt);
+    for (TransitiveLblMap* trees : {&ptrees, &strees})
+    {
+        u32_t size = ckpt.readU32();
+        for (u32_t i = 0; i < size && ckpt.good(); ++i)
+        {
+            char lbl = ckpt.readU32();
+            ckpt.read(*(*trees)[lbl]);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/* -------------------- ProgressSampler.cpp ------------------ */
+//
+// Background sampling of the progress of long runs
+//
+
+#include "CFLSolver/ProgressSampler.h"
+#include "Util/SVFUtil.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace SVF;
+
+
+ProgressSampler::ProgressSampler(u32_t _interval, const std::string& seriesFName) :
+        phase(StatReport::Read), numOfProcessed(0), numOfPending(0),
+        interval(std::max<u32_t>(1, _interval)), seriesFile(nullptr),
+        startTime(std::chrono::steady_clock::now()), lastTime(0), lastProcessed(0), stopped(false)
+{
+    if (!seriesFName.empty())
+    {
+        seriesFile = new std::ofstream(seriesFName);
+        *seriesFile << "time\tphase\tpending\tprocessed\tderived\titemsPerSec\trssKB\n";
+    }
+    thread = std::thread(&ProgressSampler::run, this);
+}
+
+
+ProgressSampler::~ProgressSampler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    stopCond.notify_one();
+    thread.join();
+
+    sample();
+    delete seriesFile;
+}
+
+
+void ProgressSampler::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopCond.wait_for(lock, std::chrono::seconds(interval), [this]
+    { return stopped; }))
+        sample();
+}
+
+
+/*!
+ * Every pushed item is a new fact, so the facts derived so far are the processed and pending items
+ */
+void ProgressSampler::sample()
+{
+    double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    u64_t processed = numOfProcessed.load(std::memory_order_relaxed);
+    s64_t pending = std::max<s64_t>(0, numOfPending.load(std::memory_order_relaxed));
+    u64_t derived = processed + pending;
+    /// processed worklist items per second
+    double rate = time > lastTime ? (processed - lastProcessed) / (time - lastTime) : 0;
+    const char* phaseName = StatReport::getPhaseName((StatReport::Phase) phase.load(std::memory_order_relaxed));
+    lastTime = time;
+    lastProcessed = processed;
+
+    u32_t vmrss = 0, vmsize = 0;
+    SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
+
+    std::cerr << "[progress] " << std::fixed << std::setprecision(1) << time << "s\t" << phaseName
+              << "\tpending " << pending << "\tprocessed " << processed << "\tderived " << derived
+              << "\t" << std::setprecision(0) << rate << " items/s\tRSS " << vmrss / 1024 << "MB"
+              << std::defaultfloat << std::endl;
+    if (seriesFile)
+        *seriesFile << std::fixed << std::setprecision(3) << time << "\t" << phaseName << "\t" << pending << "\t"
+                    << processed << "\t" << derived << "\t" << std::setprecision(0) << rate << "\t" << vmrss
+                    << std::defaultfloat << std::endl;
+}
@@ -0,0 +1,207 @@
+/* -------------------- RSMCFL.cpp ------------------ */
+//
+// CFL-reachability on recursive state machines
+//
+
+#include "CFLSolver/CFLSolver.h"
+
+using namespace SVF;
+
+
+StdCFL* RSMCFL::createComponentSolver()
+{
+    RSMCFL* comp = new RSMCFL(grammarName, graphName);
+    comp->rsm = rsm;
+    comp->symbToLabel = symbToLabel;
+    return comp;
+}
+
+
+/*!
+ * Parse the RSM, and register its labels as CFG symbols (with and without index) for reading the graph
+ */
+void RSMCFL::readGrammar()
+{
+    rsm.parseRSM(grammarName);
+    if (!rsm.getInitState().first.empty())
+        std::cout << "Boxes of the initial state are ignored" << std::endl;
+
+    _grammar = new CFG();
+    for (char lbl = 1; lbl <= rsm.getNumOfLabels(); ++lbl)
+    {
+        std::string lblStr = rsm.getLabelStr(lbl);
+        std::string idxLblStr = lblStr + "_i";
+        _grammar->addSymbol(lblStr);
+        _grammar->addSymbol(idxLblStr);
+        symbToLabel[_grammar->getSymbolId(lblStr)] = lbl;
+        symbToLabel[_grammar->getSymbolId(idxLblStr)] = lbl;
+    }
+}
+
+
+void RSMCFL::initSolver()
+{
+    u32_t initState = rsm.getInitState().second;
+    for (auto nIter = graph()->begin(); nIter != graph()->end(); ++nIter)
+        addSummary(nIter->first, nIter->first, initState, initState);
+}
+
+
+void RSMCFL::processCFLItem(CFLItem item)
+{
+    NodeID src = item.src();
+    NodeID dst = item.dst();
+    u32_t srcState = item.label().first;
+    u32_t dstState = item.label().second;
+
+    /// extend the summary by a local transition, or enter a box
+    CFLNode* node = graph()->getGNode(dst);
+    u32_t flatState = rsm.toFlatState(0, dstState);
+    for (auto it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it != eit; ++it)
+    {
+        Label lbl = edgeLabel(*it);
+        u32_t next = rsm.flatTransition(flatState, lbl.first);
+        if (!next)
+            continue;
+
+        if (!rsm.boxOfFlatState(next))
+            addSummary(src, (*it)->getDstID(), srcState, next);
+        else
+            enterFrame((*it)->getDstID(), rsm.localOfFlatState(next),
+                       FrameTy(src, srcState, rsm.boxOfFlatState(next), lbl.second));
+    }
+
+    /// exit the boxes entered at src
+    auto nIt = frames.find(src);
+    if (nIt == frames.end())
+        return;
+    auto sIt = nIt->second.find(srcState);
+    if (sIt == nIt->second.end())
+        return;
+    std::vector<FrameTy> entered(sIt->second.begin(), sIt->second.end());
+    for (const FrameTy& frame : entered)
+        exitFrame(frame, dst, dstState);
+}
+
+
+void RSMCFL::addSummary(NodeID src, NodeID dst, u32_t srcState, u32_t dstState)
+{
+    if (checkAndAddEdge(src, dst, Label(srcState, dstState)))
+        pushIntoWorklist(src, dst, Label(srcState, dstState));
+}
+
+
+void RSMCFL::enterFrame(NodeID entry, u32_t state, const FrameTy& frame)
+{
+    if (!frames[entry][state].insert(frame).second)
+        return;
+
+    addSummary(entry, entry, state, state);
+
+    /// exit along the summaries already found from the entry
+    std::vector<std::pair<u32_t, NodeBS>> summaries;
+    CFLData::TypeMap& succs = cflData()->getSuccs(entry);
+    for (auto it = succs.lower_bound(Label(state, 0)); it != succs.end() && it->first.first == state; ++it)
+        summaries.emplace_back(it->first.second, it->second);
+    for (auto& summary : summaries)
+        for (NodeID dst : summary.second)
+            exitFrame(frame, dst, summary.first);
+}
+
+
+/*!
+ * Pop the box of a frame by an out edge of node, which must have no local transition in the state
+ */
+void RSMCFL::exitFrame(const FrameTy& frame, NodeID node, u32_t state)
+{
+    CFLNode* cflNode = graph()->getGNode(node);
+    u32_t localState = rsm.toFlatState(0, state);
+    u32_t boxedState = rsm.toFlatState(std::get<2>(frame), state);
+    for (auto it = cflNode->OutEdgeBegin(), eit = cflNode->OutEdgeEnd(); it != eit; ++it)
+    {
+        Label lbl = edgeLabel(*it);
+        if (lbl.second != std::get<3>(frame) || rsm.flatTransition(localState, lbl.first))
+            continue;
+
+        u32_t next = rsm.flatTransition(boxedState, lbl.first);
+        if (!next)
+            continue;
+
+        if (!rsm.boxOfFlatState(next))
+            addSummary(std::get<0>(frame), (*it)->getDstID(), std::get<1>(frame), next);
+        else
+            enterFrame((*it)->getDstID(), rsm.localOfFlatState(next),
+                       FrameTy(std::get<0>(frame), std::get<1>(frame), rsm.boxOfFlatState(next), lbl.second));
+    }
+}
+
+
+void RSMCFL::countSumEdges()
+{
+    StdCFL::countSumEdges();
+    stat->numOfSumEdges += graph()->getCFLEdges().size();     // terminal edges are kept in the graph
+}
+
+
+/*!
+ * S pairs are the summaries from the initial state to an accepting state with no box
+ */
+void RSMCFL::materialize()
+{
+    u32_t initState = rsm.getInitState().second;
+    stat->sEdgeSet.clear();
+    for (auto& it1 : cflData()->getSuccMap())
+        for (auto& it2 : it1.second)
+        {
+            GStateTy gState;
+            gState.second = it2.first.second;
+            if (it2.first.first == initState && rsm.isAcptState(gState))
+                stat->sEdgeSet[it1.first] |= it2.second;
+        }
+
+    for (auto& it : stat->sEdgeSet)
+        it.second.reset(it.first);
+}
+
+
+/*!
+ * The frames as (entry, state, src, local state, box, idx) tuples
+ */
+void RSMCFL::writeState(Checkpoint& ckpt)
+{
+    StdCFL::writeState(ckpt);
+    u32_t numOfFrames = 0;
+    for (auto& nodeIt : frames)
+        for (auto& stateIt : nodeIt.second)
+            numOfFrames += stateIt.second.size();
+
+    ckpt.write(numOfFrames);
+    for (auto& nodeIt : frames)
+        for (auto& stateIt : nodeIt.second)
+            for (const FrameTy& frame : stateIt.second)
+            {
+                ckpt.write(nodeIt.first);
+                ckpt.write(stateIt.first);
+                ckpt.write(std::get<0>(frame));
+                ckpt.write(std::get<1>(frame));
+                ckpt.write(std::get<2>(frame));
+                ckpt.write(std::get<3>(frame));
+            }
+}
+
+
+void RSMCFL::readState(Checkpoint& ckpt)
+{
+    StdCFL::readState(ckpt);
+    u32_t numOfFrames = ckpt.readU32();
+    for (u32_t i = 0; i < numOfFrames && ckpt.good(); ++i)
+    {
+        NodeID entry = ckpt.readU32();
+        u32_t state = ckpt.readU32();
+        NodeID src = ckpt.readU32();
+        u32_t localState = ckpt.readU32();
+        u32_t box = ckpt.readU32();
+        u32_t idx = ckpt.readU32();
+        frames[entry][state].insert(FrameTy(src, localState, box, idx));
+    }
+}
@@ -0,0 +1,272 @@
+/* -------------------- RegularFilter.cpp ------------------ */
+//
+// Regular approximation of grammars for pruning irrelevant edges
+//
+
+#include "CFLSolver/RegularFilter.h"
+
+using namespace SVF;
+
+
+RegularFilter::RegularFilter(const CFG& grammar) : numOfTerms(0), numOfParens(0), enabled(false),
+                                                   startStates(0), acceptStates(0)
+{
+    buildAutomaton(grammar);
+    for (auto& it : symbToTerm)
+        kindToTerm[it.first] = it.second;
+}
+
+
+RegularFilter::RegularFilter(const CFG& grammar, const Map<CFLEdge::GEdgeKind, CFGSymbTy>& kindToSymb)
+        : numOfTerms(0), numOfParens(0), enabled(false), startStates(0), acceptStates(0)
+{
+    buildAutomaton(grammar);
+    for (auto& it : kindToSymb)
+    {
+        auto tIt = symbToTerm.find(it.second);
+        if (tIt != symbToTerm.end())
+            kindToTerm[it.first] = tIt->second;
+    }
+}
+
+
+void RegularFilter::buildAutomaton(const CFG& grammar)
+{
+    /// terminals are the symbols produced by no rule
+    Map<CFGSymbTy, u32_t> numOfProds;
+    Map<CFGSymbTy, u32_t> numOfUses;
+    for (CFGSymbTy lhs : grammar.emptyRules)
+        numOfProds[lhs]++;
+    for (auto& rule : grammar.unaryRules)
+        for (CFGSymbTy lhs : rule.second)
+        {
+            numOfProds[lhs]++;
+            numOfUses[rule.first]++;
+        }
+    for (auto& rule : grammar.binaryRules)
+        for (CFGSymbTy lhs : rule.second)
+        {
+            numOfProds[lhs]++;
+            numOfUses[rule.first.first]++;
+            numOfUses[rule.first.second]++;
+        }
+    for (auto& it : grammar.intToSymbMap)
+        if (numOfProds.find(it.first) == numOfProds.end())
+            symbToTerm[it.first] = numOfTerms++;
+
+    if (grammar.countSymbols.empty() || numOfTerms + 1 > maxNumOfStates)
+        return;
+    enabled = true;
+
+    /// the approximation of each symbol: whether it derives epsilon, the first and last terminals
+    /// of its strings, and the pairs of terminals adjacent in its strings
+    struct Approx
+    {
+        bool nullable = false;
+        u64_t first = 0;
+        u64_t last = 0;
+        std::vector<u64_t> follows;
+    };
+    Map<CFGSymbTy, Approx> approx;
+    for (auto& it : grammar.intToSymbMap)
+        approx[it.first].follows.resize(numOfTerms, 0);
+    for (auto& it : symbToTerm)
+    {
+        approx[it.first].first = (u64_t) 1 << it.second;
+        approx[it.first].last = (u64_t) 1 << it.second;
+    }
+
+    auto merge = [&](Approx& x, bool nullable, u64_t first, u64_t last, const std::vector<u64_t>& follows)
+    {
+        bool changed = nullable && !x.nullable;
+        x.nullable |= nullable;
+        changed |= (first & ~x.first) || (last & ~x.last);
+        x.first |= first;
+        x.last |= last;
+        for (u32_t t = 0; t < numOfTerms; ++t)
+        {
+            changed |= (follows[t] & ~x.follows[t]) != 0;
+            x.follows[t] |= follows[t];
+        }
+        return changed;
+    };
+
+    bool changed = true;
+    std::vector<u64_t> follows(numOfTerms);
+    while (changed)
+    {
+        changed = false;
+        for (CFGSymbTy lhs : grammar.emptyRules)
+            changed |= merge(approx[lhs], true, 0, 0, approx[lhs].follows);
+        for (auto& rule : grammar.unaryRules)
+        {
+            const Approx& y = approx[rule.first];
+            for (CFGSymbTy lhs : rule.second)
+                changed |= merge(approx[lhs], y.nullable, y.first, y.last, y.follows);
+        }
+        for (auto& rule : grammar.binaryRules)
+        {
+            const Approx& y = approx[rule.first.first];
+            const Approx& z = approx[rule.first.second];
+            for (u32_t t = 0; t < numOfTerms; ++t)
+                follows[t] = y.follows[t] | z.follows[t] | ((y.last >> t & 1) ? z.first : 0);
+            u64_t first = y.first | (y.nullable ? z.first : 0);
+            u64_t last = z.last | (z.nullable ? y.last : 0);
+            for (CFGSymbTy lhs : rule.second)
+                changed |= merge(approx[lhs], y.nullable && z.nullable, first, last, follows);
+        }
+    }
+
+    Approx count;
+    count.follows.resize(numOfTerms, 0);
+    for (CFGSymbTy s : grammar.countSymbols)
+        merge(count, approx[s].nullable, approx[s].first, approx[s].last, approx[s].follows);
+
+    /// parentheses: X ::= o Y and Z ::= X c, where o, c and X occur nowhere else
+    auto isTerm = [&](CFGSymbTy s)
+    { return symbToTerm.find(s) != symbToTerm.end(); };
+    auto usedOnce = [&](CFGSymbTy s)
+    { return numOfUses[s] == 1 && grammar.countSymbols.find(s) == grammar.countSymbols.end(); };
+    Map<u32_t, u32_t> openToParen;
+    Map<u32_t, u32_t> closeToParen;
+    u32_t maxNumOfParens = 0;
+    while ((numOfTerms + 1) << (maxNumOfParens + 1) <= maxNumOfStates)
+        maxNumOfParens++;
+    for (auto& openRule : grammar.binaryRules)
+    {
+        CFGSymbTy o = openRule.first.first;
+        if (!isTerm(o) || !usedOnce(o) || openRule.second.size() != 1)
+            continue;
+        CFGSymbTy x = *openRule.second.begin();
+        if (numOfProds[x] != 1 || !usedOnce(x))
+            continue;
+        for (auto& closeRule : grammar.binaryRules)
+        {
+            CFGSymbTy c = closeRule.first.second;
+            if (closeRule.first.first != x || !isTerm(c) || c == o || !usedOnce(c))
+                continue;
+            if (numOfParens < maxNumOfParens)
+            {
+                openToParen[symbToTerm[o]] = numOfParens;
+                closeToParen[symbToTerm[c]] = numOfParens;
+                numOfParens++;
+            }
+        }
+    }
+
+    /// state (open parentheses, last terminal), where the last terminal numOfTerms means no terminal yet
+    u32_t numOfLasts = numOfTerms + 1;
+    transitions.assign(maxNumOfStates * numOfTerms, 0);
+    for (u32_t open = 0; open < (1u << numOfParens); ++open)
+        for (u32_t last = 0; last < numOfLasts; ++last)
+        {
+            u32_t state = open * numOfLasts + last;
+            u64_t nextTerms = last == numOfTerms ? count.first : count.follows[last];
+            for (u32_t t = 0; t < numOfTerms; ++t)
+            {
+                if (!(nextTerms >> t & 1))
+                    continue;
+                StateSet& nextStates = transitions[state * numOfTerms + t];
+                auto oIt = openToParen.find(t);
+                auto cIt = closeToParen.find(t);
+                if (oIt != openToParen.end())
+                    nextStates |= (StateSet) 1 << ((open | 1u << oIt->second) * numOfLasts + t);
+                else if (cIt != closeToParen.end())
+                {
+                    if (!(open >> cIt->second & 1))
+                        continue;
+                    /// the closed kind may still be open at an outer level
+                    nextStates |= (StateSet) 1 << (open * numOfLasts + t);
+                    nextStates |= (StateSet) 1 << ((open & ~(1u << cIt->second)) * numOfLasts + t);
+                }
+                else
+                    nextStates |= (StateSet) 1 << (open * numOfLasts + t);
+            }
+        }
+
+    startStates = (StateSet) 1 << numOfTerms;
+    for (u32_t t = 0; t < numOfTerms; ++t)
+        if (count.last >> t & 1)
+            acceptStates |= (StateSet) 1 << t;
+}
+
+
+std::vector<CFLEdge*> RegularFilter::findIrrelevantEdges(const GraphTy* graph) const
+{
+    std::vector<CFLEdge*> irrelevantEdges;
+    if (!enabled)
+        return irrelevantEdges;
+
+    /// dense node indices and the terminal of each edge; edges labeled by non-terminals keep the graph as is
+    Map<NodeID, u32_t> nodeToIdx;
+    std::vector<CFLNode*> nodes;
+    for (auto it = graph->begin(), eit = graph->end(); it != eit; ++it)
+    {
+        nodeToIdx[it->first] = nodes.size();
+        nodes.push_back(it->second);
+        for (auto eIt = it->second->OutEdgeBegin(), eEit = it->second->OutEdgeEnd(); eIt != eEit; ++eIt)
+            if (kindToTerm.find((*eIt)->getEdgeKind()) == kindToTerm.end())
+                return irrelevantEdges;
+    }
+    auto termOf = [&](const CFLEdge* edge)
+    { return kindToTerm.find(edge->getEdgeKind())->second; };
+
+    /// fwd: states reachable at a node from the start state at any node;
+    /// bwd: states at a node from which an accept state at some node is reachable
+    std::vector<StateSet> fwd(nodes.size(), startStates);
+    std::vector<StateSet> bwd(nodes.size(), acceptStates);
+    std::vector<u32_t> worklist;
+    std::vector<char> inList(nodes.size(), 1);
+
+    for (u32_t i = 0; i < nodes.size(); ++i)
+        worklist.push_back(i);
+    while (!worklist.empty())
+    {
+        u32_t i = worklist.back();
+        worklist.pop_back();
+        inList[i] = 0;
+        for (auto eIt = nodes[i]->OutEdgeBegin(), eEit = nodes[i]->OutEdgeEnd(); eIt != eEit; ++eIt)
+        {
+            u32_t j = nodeToIdx[(*eIt)->getDstID()];
+            StateSet reached = next(fwd[i], termOf(*eIt));
+            if (!(reached & ~fwd[j]))
+                continue;
+            fwd[j] |= reached;
+            if (!inList[j])
+            {
+                inList[j] = 1;
+                worklist.push_back(j);
+            }
+        }
+    }
+
+    inList.assign(nodes.size(), 1);
+    for (u32_t i = 0; i < nodes.size(); ++i)
+        worklist.push_back(i);
+    while (!worklist.empty())
+    {
+        u32_t j = worklist.back();
+        worklist.pop_back();
+        inList[j] = 0;
+        for (auto eIt = nodes[j]->InEdgeBegin(), eEit = nodes[j]->InEdgeEnd(); eIt != eEit; ++eIt)
+        {
+            u32_t i = nodeToIdx[(*eIt)->getSrcID()];
+            StateSet reached = prev(bwd[j], termOf(*eIt));
+            if (!(reached & ~bwd[i]))
+                continue;
+            bwd[i] |= reached;
+            if (!inList[i])
+            {
+                inList[i] = 1;
+                worklist.push_back(i);
+            }
+        }
+    }
+
+    for (u32_t i = 0; i < nodes.size(); ++i)
+        for (auto eIt = nodes[i]->OutEdgeBegin(), eEit = nodes[i]->OutEdgeEnd(); eIt != eEit; ++eIt)
+            if (!(next(fwd[i], termOf(*eIt)) & bwd[nodeToIdx[(*eIt)->getDstID()]]))
+                irrelevantEdges.push_back(*eIt);
+
+    return irrelevantEdges;
+}
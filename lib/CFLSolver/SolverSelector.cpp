@@ -0,0 +1,307 @@
+/* -------------------- SolverSelector.cpp ------------------ */
+//
+// Selection of solvers and simplifications from input features
+//
+
+#include "CFLSolver/SolverSelector.h"
+#include "CFLSolver/CFLComponents.h"
+#include "CFLSolver/CFLOpt.h"
+#include "CFLData/CFGOptimizer.h"
+#include "Util/SVFUtil.h"
+#include <fstream>
+#include <iostream>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/// the solver options of cfl, aa and vf
+static const char* solverOptions[] = {"std", "pocr", "hpocr", "focr", "trold", "tr", "bsecg", "rsm", "gspan", "gr", "grgspan"};
+
+
+SolverSelector::SolverSelector(int argc, char** argv) : solver(Std)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.size() < 2 || arg[0] != '-')
+            continue;
+        arg = arg.substr(arg[1] == '-' ? 2 : 1);
+        givenOptions.insert(arg.substr(0, arg.find('=')));
+    }
+    for (const char* name : solverOptions)
+        if (isGiven(name))
+            givenSolver = name;
+}
+
+
+SolverSelector::SolverTy SolverSelector::selectCFL(std::string grammarName, const std::string& graphName)
+{
+    readGrammarFeatures(grammarName);
+    readGraphFeatures(graphName, "");
+
+    /// the grammar optimizer never increases the derived edges
+    selectOption("gopt", CFLOpt::optGrammar);
+
+    /// the closures only become transitive symbols under -gopt, which rewrites only the closures POCR and FOCR support
+    u32_t numOfClosureSymbols = CFLOpt::optGrammar() ? grammarFeatures.numOfClosureSymbols : 0;
+    if (grammarFeatures.numOfTransitiveSymbols || numOfClosureSymbols)
+        selectSolver(Focr);
+    else
+        selectSolver(Std);
+
+    selectComponents();
+    return solver;
+}
+
+
+SolverSelector::SolverTy SolverSelector::selectAA(const std::string& pegName)
+{
+    readGraphFeatures(pegName, "a");
+
+    selectSolver(Pocr);
+    selectSCC();
+    if (CFLOpt::scc())
+        selectOption("pe", CFLOpt::pe);
+    selectComponents();
+    return solver;
+}
+
+
+SolverSelector::SolverTy SolverSelector::selectVFA(const std::string& vfgName)
+{
+    readGraphFeatures(vfgName, "a");
+
+    selectSolver(Focr);
+    selectSCC();
+    selectComponents();
+    return solver;
+}
+
+
+void SolverSelector::selectSolver(SolverTy ty)
+{
+    solver = givenSolver.empty() ? ty : Given;
+}
+
+
+/*!
+ * Turn on a simplification option unless it is given on the command line
+ */
+void SolverSelector::selectOption(const std::string& name, Option<bool>& opt)
+{
+    if (isGiven(name))
+        return;
+    opt.setValue(true);
+    options.push_back("-" + name);
+}
+
+
+/*!
+ * Merging cycles pays off only if the copy edges form any
+ */
+void SolverSelector::selectSCC()
+{
+    if (graphFeatures.numOfCycleNodes)
+        selectOption("scc", CFLOpt::scc);
+}
+
+
+/*!
+ * Components are solved in parallel only if there are threads to use and no component dominates
+ */
+void SolverSelector::selectComponents()
+{
+    if (CFLComponents::numOfThreads() < 2 || graphFeatures.numOfComponents < 2
+        || graphFeatures.maxComponentSize * 2 > graphFeatures.numOfNodes)
+        return;
+    selectOption("wcc", CFLOpt::wcc);
+}
+
+
+/*!
+ * Node, edge and label counts, weakly connected components over all edges,
+ * and SCCs over the edges labeled cycleLabel (all edges if it is empty)
+ */
+void SolverSelector::readGraphFeatures(const std::string& fname, const std::string& cycleLabel)
+{
+    std::ifstream gFile;
+    gFile.open(fname, std::ios::in);
+    if (!gFile.is_open())
+    {
+        std::cout << "error opening " << fname << std::endl;
+        exit(0);
+    }
+
+    Map<NodeID, u32_t> nodeToIdx;
+    Map<std::string, u32_t> labelCounts;
+    std::vector<std::pair<u32_t, u32_t>> edges;
+    std::vector<std::pair<u32_t, u32_t>> cycleEdges;
+    auto getIdx = [&](NodeID id)
+    { return nodeToIdx.emplace(id, nodeToIdx.size()).first->second; };
+
+    std::string line;
+    while (getline(gFile, line))
+    {
+        std::vector<std::string> vec = split(line, '\t');
+        if (vec.size() < 3)
+            continue;
+
+        u32_t src = getIdx(stoi(vec[0]));
+        u32_t dst = getIdx(stoi(vec[1]));
+        edges.emplace_back(src, dst);
+        labelCounts[vec[2]]++;
+        if (cycleLabel.empty() || vec[2] == cycleLabel)
+            cycleEdges.emplace_back(src, dst);
+    }
+    gFile.close();
+
+    u32_t numOfNodes = nodeToIdx.size();
+    graphFeatures.numOfNodes = numOfNodes;
+    graphFeatures.numOfEdges = edges.size();
+    graphFeatures.numOfLabels = labelCounts.size();
+    for (auto& it : labelCounts)
+        graphFeatures.maxLabelShare = std::max(graphFeatures.maxLabelShare, (double) it.second / edges.size());
+
+    /// union-find for weakly connected components
+    std::vector<u32_t> parent(numOfNodes);
+    for (u32_t i = 0; i < numOfNodes; ++i)
+        parent[i] = i;
+    auto findRoot = [&](u32_t x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+    for (auto& edge : edges)
+        parent[findRoot(edge.first)] = findRoot(edge.second);
+    std::vector<u32_t> compSizes(numOfNodes, 0);
+    for (u32_t i = 0; i < numOfNodes; ++i)
+        if (compSizes[findRoot(i)]++ == 0)
+            graphFeatures.numOfComponents++;
+    for (u32_t size : compSizes)
+        graphFeatures.maxComponentSize = std::max(graphFeatures.maxComponentSize, size);
+
+    /// iterative Tarjan's algorithm over the cycle edges in CSR form
+    std::vector<u32_t> offsets(numOfNodes + 1, 0);
+    for (auto& edge : cycleEdges)
+        offsets[edge.first + 1]++;
+    for (u32_t i = 0; i < numOfNodes; ++i)
+        offsets[i + 1] += offsets[i];
+    std::vector<u32_t> succs(cycleEdges.size());
+    std::vector<u32_t> pos(offsets.begin(), offsets.end() - 1);
+    for (auto& edge : cycleEdges)
+        succs[pos[edge.first]++] = edge.second;
+
+    const u32_t unvisited = UINT32_MAX;
+    std::vector<u32_t> dfsIndex(numOfNodes, unvisited);
+    std::vector<u32_t> dfsLow(numOfNodes, 0);
+    std::vector<char> onStack(numOfNodes, 0);
+    std::vector<u32_t> sccStack;
+    std::vector<std::pair<u32_t, u32_t>> callStack;     // node and its next succ offset
+    u32_t counter = 0;
+    auto visit = [&](u32_t n)
+    {
+        dfsIndex[n] = dfsLow[n] = counter++;
+        sccStack.push_back(n);
+        onStack[n] = 1;
+        callStack.emplace_back(n, offsets[n]);
+    };
+
+    for (u32_t root = 0; root < numOfNodes; ++root)
+    {
+        if (dfsIndex[root] != unvisited)
+            continue;
+
+        visit(root);
+        while (!callStack.empty())
+        {
+            u32_t n = callStack.back().first;
+            u32_t i = callStack.back().second;
+            if (i < offsets[n + 1])
+            {
+                callStack.back().second++;
+                u32_t succ = succs[i];
+                if (dfsIndex[succ] == unvisited)
+                    visit(succ);
+                else if (onStack[succ])
+                    dfsLow[n] = std::min(dfsLow[n], dfsIndex[succ]);
+                continue;
+            }
+
+            if (dfsLow[n] == dfsIndex[n])
+            {
+                u32_t size = 0;
+                u32_t m;
+                do
+                {
+                    m = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[m] = 0;
+                    size++;
+                } while (m != n);
+                if (size > 1)
+                    graphFeatures.numOfCycleNodes += size;
+                graphFeatures.maxSCCSize = std::max(graphFeatures.maxSCCSize, size);
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty())
+            {
+                u32_t parentNode = callStack.back().first;
+                dfsLow[parentNode] = std::min(dfsLow[parentNode], dfsLow[n]);
+            }
+        }
+    }
+}
+
+
+void SolverSelector::readGrammarFeatures(std::string grammarName)
+{
+    CFG grammar;
+    grammar.readGrammarFile(grammarName);
+    grammar.detectTransitiveSymbol();
+
+    grammarFeatures.numOfRules = grammar.emptyRules.size() + grammar.longRules.size();
+    for (auto& rule : grammar.unaryRules)
+        grammarFeatures.numOfUnaryRules += rule.second.size();
+    grammarFeatures.numOfRules += grammarFeatures.numOfUnaryRules;
+    for (auto& rule : grammar.binaryRules)
+        grammarFeatures.numOfRules += rule.second.size();
+    grammarFeatures.numOfTransitiveSymbols = grammar.transitiveSymbols.size();
+    grammarFeatures.numOfVariantSymbols = grammar.variableSymbols.size();
+
+    CFGOptimizer optimizer(&grammar);
+    optimizer.discoverTransitiveSymbols();
+    grammarFeatures.numOfClosureSymbols = optimizer.getNumOfNewTransitiveSymbols();
+}
+
+
+void SolverSelector::printDecision()
+{
+    static const char* solverNames[] = {"std", "pocr", "focr"};
+
+    std::cout << "Auto selection:\t-" << (solver == Given ? givenSolver : solverNames[solver]);
+    for (auto& opt : options)
+        std::cout << " " << opt;
+    std::cout << std::endl;
+
+    std::cout << "Graph:\t\t#Node = " << graphFeatures.numOfNodes
+              << ", #Edge = " << graphFeatures.numOfEdges
+              << ", Density = " << (double) graphFeatures.numOfEdges / std::max<u32_t>(1, graphFeatures.numOfNodes)
+              << ", #Label = " << graphFeatures.numOfLabels
+              << ", MaxLabelShare = " << graphFeatures.maxLabelShare
+              << ", #CycleNode = " << graphFeatures.numOfCycleNodes
+              << ", MaxSCC = " << graphFeatures.maxSCCSize
+              << ", #Component = " << graphFeatures.numOfComponents
+              << ", MaxComponent = " << graphFeatures.maxComponentSize << std::endl;
+    if (grammarFeatures.numOfRules)
+        std::cout << "Grammar:\t#Rule = " << grammarFeatures.numOfRules
+                  << ", #UnaryRule = " << grammarFeatures.numOfUnaryRules
+                  << ", #Transitive = " << grammarFeatures.numOfTransitiveSymbols
+                  << ", #Closure = " << grammarFeatures.numOfClosureSymbols
+                  << ", #Variant = " << grammarFeatures.numOfVariantSymbols << std::endl;
+    std::cout << std::endl;
+}
@@ -0,0 +1,77 @@
+/* -------------------- StatReport.cpp ------------------ */
+//
+// Phase timing and JSON statistics shared by the stats of all tools
+//
+
+#include "CFLSolver/StatReport.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sys/resource.h>
+
+using namespace SVF;
+
+
+const char* StatReport::getPhaseName(Phase phase)
+{
+    static const char* phaseNames[] = {"read", "simplify", "initSolver", "solve", "materialize"};
+    return phaseNames[phase];
+}
+
+
+u32_t StatReport::getPeakRSSKB()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+
+void StatReport::addPhaseTimes(TIMEStatMap& timeStatMap) const
+{
+    timeStatMap["ReadTime"] = phaseTimes[Read];
+    timeStatMap["InitSolverTime"] = phaseTimes[InitSolver];
+    timeStatMap["MaterializeTime"] = phaseTimes[Materialize];
+}
+
+
+void StatReport::collect(const NUMStatMap& nums, const TIMEStatMap& times)
+{
+    for (auto& it : nums)
+        numStats[it.first] = it.second;
+    for (auto& it : times)
+        timeStats[it.first] = it.second;
+}
+
+
+void StatReport::writeJSON(const std::string& fName, const std::string& tool) const
+{
+    std::ofstream out(fName);
+    if (!out)
+    {
+        std::cout << "error opening " << fName << std::endl;
+        return;
+    }
+
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n  \"tool\": \"" << tool << "\",\n  \"phases\": {";
+    for (u32_t p = 0; p < NumOfPhases; ++p)
+        out << (p ? ", " : "") << "\"" << getPhaseName((Phase) p) << "\": " << phaseTimes[p];
+    out << "},\n  \"memory\": {\"vmrssBeforeKB\": " << vmrssBefore
+        << ", \"vmrssAfterKB\": " << vmrssAfter
+        << ", \"peakRSSKB\": " << getPeakRSSKB() << "},\n  \"counters\": {";
+    bool first = true;
+    for (auto& it : numStats)
+    {
+        out << (first ? "" : ", ") << "\"" << it.first << "\": " << it.second;
+        first = false;
+    }
+    out << "},\n  \"times\": {";
+    first = true;
+    for (auto& it : timeStats)
+    {
+        out << (first ? "" : ", ") << "\"" << it.first << "\": " << it.second;
+        first = false;
+    }
+    out << "}\n}\n";
+}
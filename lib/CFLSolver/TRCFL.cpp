@@ -96,19 +96,11 @@ NodeBS TRCFL::computeDiffEdges(const NodeBS& srcSet, NodeID dst, Label lbl)
 }
 
 
-void TRCFL::countSumEdges()
+/*!
+ * S pairs of both the reduced edges in cflData and the secondary edges
+ */
+void TRCFL::materialize()
 {
-    /// calculate summary edges
-    stat->numOfSumEdges = 0;
-    for (auto it1 = cflData()->begin(); it1 != cflData()->end(); ++it1)
-        for (auto& it2 : it1->second)
-            stat->numOfSumEdges += it2.second.count();
-
-//    for (auto it1 = secondaryData.begin(); it1 != secondaryData.end(); ++it1)
-//        for (auto& it2 : it1->second)
-//            stat->numOfSumEdges += it2.second.count();
-
-    /// calculate S edges
     stat->sEdgeSet.clear();
     for (auto& it1 : cflData()->getSuccMap())
         for (auto& it2 : it1.second)
@@ -122,8 +114,19 @@ void TRCFL::countSumEdges()
 
     for (auto& it : stat->sEdgeSet)
         it.second.reset(it.first);
+}
+
 
-    stat->numOfCountEdges = 0;
-    for (auto& it1 : stat->sEdgeSet)
-        stat->numOfCountEdges += it1.second.count();
-}
\ No newline at end of file
+void TRCFL::writeState(Checkpoint& ckpt)
+{
+    StdCFL::writeState(ckpt);
+    ckpt.write(secondaryData);
+}
+
+
+void TRCFL::readState(Checkpoint& ckpt)
+{
+    StdCFL::readState(ckpt);
+    secondaryData.clear();
+    ckpt.read(secondaryData);
+}
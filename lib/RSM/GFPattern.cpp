@@ -50,7 +50,7 @@ void NPPattern::parse(std::string s, RSM* rsm)
 /*!
  * Subsumption relation
  */
-bool GFPattern::subsume(GStateTy s1, GStateTy s2, set<Label>& lblSet)
+bool GFPattern::subsume(const GStateTy& s1, const GStateTy& s2, set<Label>& lblSet)
 {
     if (!s1.second)     // a false state subsume to any other state
         return true;
@@ -58,9 +58,10 @@ bool GFPattern::subsume(GStateTy s1, GStateTy s2, set<Label>& lblSet)
     if (acptStates.find(s1) != acptStates.end() && acptStates.find(s2) == acptStates.end())
         return false;
 
+    bool pop;
     for (auto& lbl: lblSet)
     {
-        if (transition(s1, lbl).second && (transition(s1, lbl) != transition(s2, lbl)))
+        if (step(s1, lbl, pop) && !sameTransition(s1, s2, lbl))
             return false;
     }
     return true;
@@ -75,21 +76,21 @@ set<RSM::GStateTy> GFPattern::getTgtStatesOfLabels(set<Label>& lblSet)
     set<GStateTy> retSet;
     for (auto lbl: lblSet)
     {
-        for (auto& ruleMap: transRules)
+        for (u32_t flat = 1; flat < getNumOfFlatStates(); ++flat)
         {
-            if (ruleMap.second.count(lbl.first))    // find valid transition
-            {
-                /// Get valid src state
-                GStateTy src;
-                src.second = ruleMap.first.second;
-                if (!ruleMap.first.first.empty())
-                    src.first.emplace_back(ruleMap.first.first.back(), lbl.second);
-
-                /// Get target state
-                GStateTy dst = transition(src, lbl);
-                if (dst.second)
-                    retSet.insert(transition(src, lbl));
-            }
+            if (!flatTransition(flat, lbl.first))    // find valid transition
+                continue;
+
+            /// Get valid src state
+            GStateTy src;
+            src.second = localOfFlatState(flat);
+            if (boxOfFlatState(flat))
+                src.first.emplace_back(boxOfFlatState(flat), lbl.second);
+
+            /// Get target state
+            GStateTy dst = transition(src, lbl);
+            if (dst.second)
+                retSet.insert(std::move(dst));
         }
     }
     return retSet;
@@ -87,6 +87,8 @@ void RSM::parseRSM(const std::string& fname)
                 readAcptState(lineVec[1]);
         }
     }
+
+    compile();
 }
 
 
@@ -208,57 +210,85 @@ Label RSM::strToLabel(const std::string& s)
 }
 
 
-RSM::GStateTy RSM::transition(GStateTy& src, Label lbl)
+void RSM::compile()
 {
-    GStateTy retGS;
-    retGS.second = 0;
-    if (!src.second || !lbl.first)
-        return retGS;
-
-    retGS.first = src.first;
-    BoxedStateTy srcLS;
-
-    /// Check innermost local state
-    srcLS.second = src.second;
-    auto iter = transRules.find(srcLS);
-    if (iter != transRules.end() && (iter->second.find(lbl.first)) != iter->second.end())
+    u32_t numOfCols = numOfLabels + 1;
+    transTable.assign(getNumOfFlatStates() * numOfCols, 0);
+    for (auto& ruleMap: transRules)
     {
-        auto dstLs = iter->second[lbl.first];
-        if (dstLs.first.empty())    // local
-            retGS.second = dstLs.second;
-        else    // enter, idx depends only on lbl
+        u32_t srcBox = ruleMap.first.first.empty() ? 0 : ruleMap.first.first.back();
+        u32_t src = toFlatState(srcBox, ruleMap.first.second);
+        for (auto& rule: ruleMap.second)
         {
-            retGS.first.emplace_back(dstLs.first.back(), lbl.second);
-            retGS.second = dstLs.second;
+            u32_t dstBox = rule.second.first.empty() ? 0 : rule.second.first.back();
+            transTable[src * numOfCols + rule.first] = toFlatState(dstBox, rule.second.second);
         }
-        return retGS;
     }
+}
 
-    if (src.first.empty())
-        return retGS;
 
-    /// Check boxed local state
-    srcLS.first.push_back(src.first.back().first);
-    retGS.first.pop_back();
-    iter = transRules.find(srcLS);
-    if (iter != transRules.end() && (iter->second.find(lbl.first)) != iter->second.end())
-    {
-        auto dstLs = iter->second[lbl.first];
-        if (dstLs.first.empty() && src.first.back().second == lbl.second)    // exit, idx depends on both src and lbl
-        {
-            retGS.second = dstLs.second;
-        }
-        else if (src.first.back().second == lbl.second)   // exit--enter, idx depends on both src and lbl
-        {
-            retGS.first.emplace_back(dstLs.first.back(), lbl.second);
-            retGS.second = dstLs.second;
-        }
-    }
+/*!
+ * The flat dst of a global state by a label, 0 if there is no valid transition.
+ * A rule of the innermost local state takes precedence over a rule of the boxed local state,
+ * and the latter pops the innermost box (pop is set) if the box idx matches the label idx.
+ */
+u32_t RSM::step(const GStateTy& src, Label lbl, bool& pop) const
+{
+    pop = false;
+    if (!src.second || !lbl.first)
+        return 0;
+
+    u32_t dst = flatTransition(toFlatState(0, src.second), lbl.first);
+    if (dst || src.first.empty())
+        return dst;
+
+    if (src.first.back().second != lbl.second)
+        return 0;
+    pop = true;
+    return flatTransition(toFlatState(src.first.back().first, src.second), lbl.first);
+}
 
+
+RSM::GStateTy RSM::transition(const GStateTy& src, Label lbl) const
+{
+    GStateTy retGS;
+    retGS.second = 0;
+
+    bool pop;
+    u32_t dst = step(src, lbl, pop);
+    if (!dst)
+        return retGS;
+
+    retGS.first = src.first;
+    if (pop)    // exit
+        retGS.first.pop_back();
+    if (boxOfFlatState(dst))     // enter, idx depends only on lbl
+        retGS.first.emplace_back(boxOfFlatState(dst), lbl.second);
+    retGS.second = localOfFlatState(dst);
     return retGS;
 }
 
 
+/*!
+ * Whether two global states reach the same global state by a label, without constructing the targets
+ */
+bool RSM::sameTransition(const GStateTy& s1, const GStateTy& s2, Label lbl) const
+{
+    bool pop1, pop2;
+    u32_t dst1 = step(s1, lbl, pop1);
+    u32_t dst2 = step(s2, lbl, pop2);
+    if (!dst1 || !dst2)
+        return dst1 == dst2;
+    if (dst1 != dst2)
+        return false;
+
+    /// the boxes kept below the entered one must be the same
+    u32_t size1 = s1.first.size() - pop1;
+    u32_t size2 = s2.first.size() - pop2;
+    return size1 == size2 && std::equal(s1.first.begin(), s1.first.begin() + size1, s2.first.begin());
+}
+
+
 string RSM::transition(std::string& src, std::string& lbl)
 {
     stringstream ret;
@@ -20,43 +20,52 @@ void FocrVFA::initSolver()
             pushIntoWorklist(srcId,dstId,Label(a,0));
         }
         if (edge->getEdgeKind() == IVFG::CallVF)
+        {
             cflData()->addEdge(srcId, dstId, Label(call, edge->getEdgeIdx()));
+            callData.addEdge(srcId, dstId, edge->getEdgeIdx());
+        }
         if (edge->getEdgeKind() == IVFG::RetVF)
+        {
             cflData()->addEdge(srcId, dstId, Label(ret, edge->getEdgeIdx()));
+            retData.addEdge(srcId, dstId, edge->getEdgeIdx());
+        }
     }
 
+    initECG();
     for (auto it = graph()->begin(); it != graph()->end(); ++it)
-    {
-        NodeID nId = it->first;
-        ecg.addNode(nId);
-        matchCallRet(nId, nId);
-    }
+        matchCallRet(it->first, it->first);
+}
+
+
+void FocrVFA::initECG()
+{
+    ecg = ECG::createECG();
+    for (auto it = graph()->begin(); it != graph()->end(); ++it)
+        ecg->addNode(it->first);
 }
 
 
 void FocrVFA::solve()
 {
-    while (!isWorklistEmpty())
+    while (!isWorklistEmpty() && !Checkpoint::isPreempted())
     {
         CFLItem item = popFromWorklist();
         addArc(item.src(), item.dst());
     }
-
-    ecg.countECGEdges();
 }
 
 
 void FocrVFA::addArc(NodeID src, NodeID dst)
 {
-    if (ecg.isReachable(src, dst))
+    if (ecg->isReachable(src, dst))
         return;
 
     std::unordered_map<NodeID, NodeBS>* newEdgeMapPtr;
 
-    if (ecg.isReachable(dst, src))     // src --> dst is a back edge
-        newEdgeMapPtr = &ecg.insertBackEdge(src, dst);
+    if (ecg->isReachable(dst, src))     // src --> dst is a back edge
+        newEdgeMapPtr = &ecg->insertBackEdge(src, dst);
     else                                    // src --> dst is a forward edge
-        newEdgeMapPtr = &ecg.insertForwardEdge(src, dst);
+        newEdgeMapPtr = &ecg->insertForwardEdge(src, dst);
 
     for (auto& it1 : *newEdgeMapPtr)
         for (auto newDst : it1.second)
@@ -66,21 +75,23 @@ void FocrVFA::addArc(NodeID src, NodeID dst)
 
 void FocrVFA::matchCallRet(NodeID u, NodeID v)
 {
-    /// vertical handling of matched parentheses
-    for (auto& srcIt : cflData()->getPreds(u))
+    /// vertical handling of matched parentheses, only the callsites shared by u and v are visited
+    auto matchCallsite = [&](u32_t /*callsite*/, const NodeBS& callParents, const NodeBS& retChildren)
     {
-        if (srcIt.first.first == call)
-            for (auto& dstIt : cflData()->getSuccs(v))
+        for (NodeID callParent : callParents)
+            for (NodeID retChild : retChildren)
             {
-                if (dstIt.first.first == ret && srcIt.first.second == dstIt.first.second)
-                    for (NodeID srcCallParent : srcIt.second)
-                        for (NodeID dstRetChild : dstIt.second)
-                        {
-                            stat->checks++;
-                            pushIntoWorklist(srcCallParent, dstRetChild, Label(A, 0));
-                        }
+                stat->checks++;
+                pushIntoWorklist(callParent, retChild, Label(A, 0));
             }
-    }
+    };
+    IndexedData::forEachCommonIdx(callData.getPreds(u), retData.getSuccs(v), matchCallsite);
+}
+
+
+void FocrVFA::addCl(NodeID u, u32_t idx, NodeID v)
+{
+    addCl(u, idx, ecg->getNode(v));
 }
 
 
@@ -95,21 +106,108 @@ void FocrVFA::addCl(NodeID u, u32_t idx, ECGNode* vNode)
 }
 
 
-void FocrVFA::countSumEdges()
+/*!
+ * Cl edges are left implicit while solving
+ */
+void FocrVFA::materialize()
 {
-    /// calculate checks
-    stat->checks += ecg.checks;
-
     /// calculate summary edges
     for (auto& it1 : cflData()->getSuccMap())
         for (auto& it2 : it1.second)
             if (it2.first.first == call)
             {
                 for (NodeID dst : it2.second)
-                    addCl(it1.first, it2.first.second, ecg.getNode(dst));
+                    addCl(it1.first, it2.first.second, dst);
             }
+}
+
+
+void FocrVFA::countSumEdges()
+{
+    /// calculate checks and ECG edges
+    stat->checks += ecgChecks();
+    stat->numOfECGEdges += countECGEdges();
 
     VFAnalysis::countSumEdges();
-    stat->numOfSumEdges += ecg.countReachablePairs();
-    stat->numOfSEdges += ecg.countReachablePairs();
+    stat->numOfSumEdges += countReachablePairs();
+    stat->numOfSEdges += countReachablePairs();
+}
+
+
+/*!
+ * The A edges are the reachable pairs of the ECG
+ */
+void FocrVFA::collectValueFlowPairs(PairMap& pairs)
+{
+    VFAnalysis::collectValueFlowPairs(pairs);
+    if (components.empty())     // with -wcc, only the components have ECGs
+        collectReachablePairs(pairs);
+}
+
+
+/* -------------------- BSFocrVFA ------------------ */
+
+void BSFocrVFA::initECG()
+{
+    for (auto it = graph()->begin(); it != graph()->end(); ++it)
+        bsecg.addNode(it->first);
+}
+
+
+void BSFocrVFA::addArc(NodeID src, NodeID dst)
+{
+    if (bsecg.isReachable(src, dst))
+        return;
+
+    std::unordered_map<NodeID, NodeBS>* newEdgeMapPtr;
+
+    if (bsecg.isReachable(dst, src))     // src --> dst is a back edge
+        newEdgeMapPtr = &bsecg.insertBackEdge(src, dst);
+    else                                    // src --> dst is a forward edge
+        newEdgeMapPtr = &bsecg.insertForthEdge(src, dst);
+
+    for (auto& it1 : *newEdgeMapPtr)
+        for (auto newDst : it1.second)
+            matchCallRet(it1.first, newDst);    // it1.first == newSrc
+}
+
+
+void BSFocrVFA::addCl(NodeID u, u32_t idx, NodeID v)
+{
+    if (!checkAndAddEdge(u, v, Label(Cl, idx)))
+        return;
+
+    for (auto succ : bsecg.getSuccs(v))
+        addCl(u, idx, succ);
+}
+
+
+void FocrVFA::writeState(Checkpoint& ckpt)
+{
+    VFAnalysis::writeState(ckpt);
+    ckpt.write(*ecg);
+}
+
+
+void FocrVFA::readState(Checkpoint& ckpt)
+{
+    VFAnalysis::readState(ckpt);
+    ckpt.read(*ecg);
+}
+
+
+/*!
+ * The bit set-based ECG replaces the ECG of the base solver
+ */
+void BSFocrVFA::writeState(Checkpoint& ckpt)
+{
+    VFAnalysis::writeState(ckpt);
+    ckpt.write(bsecg);
+}
+
+
+void BSFocrVFA::readState(Checkpoint& ckpt)
+{
+    VFAnalysis::readState(ckpt);
+    ckpt.read(bsecg);
 }
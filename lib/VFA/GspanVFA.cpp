@@ -117,3 +117,28 @@ void GspanVFA::countSumEdges()
         }
     }
 }
+
+
+void GspanVFA::collectValueFlowPairs(PairMap& pairs)
+{
+    VFAnalysis::collectValueFlowPairs(pairs);
+    addValueFlowPairs(oldData(), pairs);
+}
+
+
+/*!
+ * The facts of the last round are in cflData, all earlier facts in oldData
+ */
+void GspanVFA::writeState(Checkpoint& ckpt)
+{
+    StdVFA::writeState(ckpt);
+    ckpt.write(*oldData());
+}
+
+
+void GspanVFA::readState(Checkpoint& ckpt)
+{
+    StdVFA::readState(ckpt);
+    oldData()->clear();
+    ckpt.read(*oldData());
+}
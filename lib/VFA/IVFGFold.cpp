@@ -32,6 +32,7 @@ void IVFGFold::foldGraph()
         if (src == dst)
             continue;
 
+        foldedNodes |= lg->subNodeIds(dst);
         lg->mergeNodeToRep(dst, src);
     }
 }
@@ -19,9 +19,15 @@ void PocrVFA::initSolver()
             pushIntoWorklist(srcId, dstId, Label(a, 0));
         }
         if (edge->getEdgeKind() == IVFG::CallVF)
+        {
             cflData()->addEdge(srcId, dstId, Label(call, edge->getEdgeIdx()));
+            callData.addEdge(srcId, dstId, edge->getEdgeIdx());
+        }
         if (edge->getEdgeKind() == IVFG::RetVF)
+        {
             cflData()->addEdge(srcId, dstId, Label(ret, edge->getEdgeIdx()));
+            retData.addEdge(srcId, dstId, edge->getEdgeIdx());
+        }
     }
 
     for (auto it = graph()->begin(); it != graph()->end(); ++it)
@@ -35,7 +41,7 @@ void PocrVFA::initSolver()
 
 void PocrVFA::solve()
 {
-    while (!isWorklistEmpty())
+    while (!isWorklistEmpty() && !Checkpoint::isPreempted())
     {
         CFLItem item = popFromWorklist();
         auto& newEdgeMap = hybridData.addArc(item.src(), item.dst());
@@ -52,21 +58,17 @@ void PocrVFA::solve()
  */
 void PocrVFA::matchCallRet(NodeID u, NodeID v)
 {
-    /// vertical handling of matched parentheses
-    for (auto& srcIt : cflData()->getPreds(u))
+    /// vertical handling of matched parentheses, only the callsites shared by u and v are visited
+    auto matchCallsite = [&](u32_t /*callsite*/, const NodeBS& callParents, const NodeBS& retChildren)
     {
-        if (srcIt.first.first == call)
-            for (auto& dstIt : cflData()->getSuccs(v))
+        for (NodeID callParent : callParents)
+            for (NodeID retChild : retChildren)
             {
-                if (dstIt.first.first == ret && srcIt.first.second == dstIt.first.second)
-                    for (NodeID srcTgt : srcIt.second)
-                        for (NodeID dstTgt : dstIt.second)
-                        {
-                            stat->checks++;
-                            pushIntoWorklist(srcTgt, dstTgt, Label(A, 0));
-                        }
+                stat->checks++;
+                pushIntoWorklist(callParent, retChild, Label(A, 0));
             }
-    }
+    };
+    IndexedData::forEachCommonIdx(callData.getPreds(u), retData.getSuccs(v), matchCallsite);
 }
 
 
@@ -81,11 +83,11 @@ void PocrVFA::addCl(NodeID u, u32_t idx, TreeNode* vNode)
 }
 
 
-void PocrVFA::countSumEdges()
+/*!
+ * Cl edges are left implicit while solving
+ */
+void PocrVFA::materialize()
 {
-    /// calculate checks
-    stat->checks += hybridData.checks;
-
     /// calculate summary edges
     for (auto& it1 : cflData()->getSuccMap())
         for (auto& it2 : it1.second)
@@ -94,6 +96,13 @@ void PocrVFA::countSumEdges()
                 for (NodeID dst : it2.second)
                     addCl(it1.first, it2.first.second, hybridData.getNode(dst, dst));
             }
+}
+
+
+void PocrVFA::countSumEdges()
+{
+    /// calculate checks
+    stat->checks += hybridData.checks;
 
     VFAnalysis::countSumEdges();
 
@@ -105,3 +114,27 @@ void PocrVFA::countSumEdges()
 }
 
 
+/*!
+ * The A edges are the nodes of the trees, indMap[v][u] being v in the tree of u
+ */
+void PocrVFA::collectValueFlowPairs(PairMap& pairs)
+{
+    VFAnalysis::collectValueFlowPairs(pairs);
+    for (auto& iter : hybridData.indMap)
+        for (auto& slot : iter.second)
+            pairs[slot.first].set(iter.first);
+}
+
+
+void PocrVFA::writeState(Checkpoint& ckpt)
+{
+    VFAnalysis::writeState(ckpt);
+    ckpt.write(hybridData);
+}
+
+
+void PocrVFA::readState(Checkpoint& ckpt)
+{
+    VFAnalysis::readState(ckpt);
+    ckpt.read(hybridData);
+}
@@ -4,6 +4,8 @@
 //
 
 #include "VFA/VFAnalysis.h"
+#include "CFLSolver/ParallelSCC.h"
+#include "CFLSolver/RegularFilter.h"
 
 using namespace SVF;
 
@@ -11,6 +13,10 @@ void VFAnalysis::simplifyGraph()
 {
     double startClk = stat->getClk();
 
+    if (CFLOpt::preFilter())
+    {
+        preFilter();
+    }
     if (CFLOpt::scc() || CFLOpt::graphSimp())
     {
         SCCElimination();
@@ -29,6 +35,36 @@ void VFAnalysis::simplifyGraph()
 }
 
 
+/*!
+ * Remove the edges lying on no valueflow path of the grammar hard-coded by the solvers
+ */
+void VFAnalysis::preFilter()
+{
+    double startClk = stat->getClk();
+
+    CFG vfGrammar;
+    std::vector<std::string> rules = {"A\tA\tA", "A\tCl_i\tret_i", "Cl_i\tcall_i\tA", "A\ta", "A"};
+    for (std::string& rule : rules)
+        vfGrammar.readProduction(rule);
+    std::string aSymb = "a", callSymb = "call_i", retSymb = "ret_i", countSymb = "A";
+    vfGrammar.readUCFLSymbol(countSymb, CFG::Count);
+
+    Map<CFLEdge::GEdgeKind, CFGSymbTy> kindToSymb;
+    kindToSymb[IVFG::DirectVF] = vfGrammar.getSymbolId(aSymb);
+    kindToSymb[IVFG::CallVF] = vfGrammar.getSymbolId(callSymb);
+    kindToSymb[IVFG::RetVF] = vfGrammar.getSymbolId(retSymb);
+
+    RegularFilter filter(vfGrammar, kindToSymb);
+    std::vector<CFLEdge*> edges = filter.findIrrelevantEdges(_graph);
+    for (CFLEdge* edge : edges)
+        graph()->removeIVFGEdge(edge);
+    stat->numOfPrunedEdges = edges.size();
+
+    double endClk = stat->getClk();
+    stat->prefilterTime = (endClk - startClk) / TIMEINTERVAL;
+}
+
+
 void VFAnalysis::graphFolding()
 {
     double startClk = stat->getClk();
@@ -65,9 +101,18 @@ void VFAnalysis::SCCElimination()
 {
     double startClk = stat->getClk();
 
-    if (!scc)
-        scc = new SCC(_graph);
-    SCCDetect();
+    if (CFLOpt::parallelSCC())
+    {
+        ParallelSCC pscc(_graph);
+        pscc.find();
+        graph()->mergeNodesToReps(pscc.getSCCs());
+    }
+    else
+    {
+        if (!scc)
+            scc = new SCC(_graph);
+        SCCDetect();
+    }
 
     double endClk = stat->getClk();
     stat->sccTime = (endClk - startClk) / TIMEINTERVAL;
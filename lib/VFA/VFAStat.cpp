@@ -29,6 +29,7 @@ void VFAStat::printStat(std::string statname)
     }
 
     std::cout.flush();
+    report.collect(PTNumStatMap, timeStatMap);
     PTNumStatMap.clear();
     timeStatMap.clear();
 }
@@ -47,6 +48,13 @@ void VFAStat::vfgStat()
     PTNumStatMap["#Nodes"] = numOfNodes;
     PTNumStatMap["#Edges"] = numOfEdges;
     timeStatMap["GraphSimpTime"] = gsTime;
+    if (CFLOpt::preFilter())
+    {
+        timeStatMap["PrefilterTime"] = prefilterTime;
+        PTNumStatMap["#PrunedEdges"] = numOfPrunedEdges;
+    }
+    if (CFLOpt::scc() || CFLOpt::graphSimp())
+        timeStatMap["SCCTime"] = sccTime;
 
     VFAStat::printStat("VFG Stats");
 }
@@ -60,17 +68,48 @@ void VFAStat::performStat()
         vfgStat();
 
     if (!CFLOpt::PStat())
+    {
+        writeReport();
         return;
+    }
 
-    ivf->countSumEdges();
+    /// the materialization has its own phase, the counters are read afterwards
+    ivf->materializeResults();
+    double startClk = getClk();
+    if (CFLOpt::wcc())
+        ivf->countComponentSumEdges();
+    else
+        ivf->countSumEdges();
+    double countTime = (getClk() - startClk) / TIMEINTERVAL;
 
     timeStatMap["AnalysisTime"] = timeOfSolving;
+    timeStatMap["CountTime"] = countTime;
     timeStatMap["VmrssInGB"] = (_vmrssUsageAfter - _vmrssUsageBefore) / 1024.0 / 1024.0;
+    timeStatMap["PeakVmrssInGB"] = StatReport::getPeakRSSKB() / 1024.0 / 1024.0;
+    report.addPhaseTimes(timeStatMap);
     PTNumStatMap["#Checks"] = checks;
     PTNumStatMap["#SumEdges"] = numOfSumEdges - numOfEdges;
     PTNumStatMap["#SEdges"] = numOfSEdges;
+    if (numOfECGEdges)
+        PTNumStatMap["#ECGEdge"] = numOfECGEdges;
+    if (CFLOpt::wcc())
+        PTNumStatMap["#Components"] = numOfComponents;
 
     VFAStat::printStat("CFL-reachability analysis Stats");
+    writeReport();
+}
+
+
+void VFAStat::writeReport()
+{
+    if (CFLOpt::statFName().empty())
+        return;
+
+    report.phaseTimes[StatReport::Simplify] = gsTime;
+    report.phaseTimes[StatReport::Solve] = timeOfSolving;
+    report.vmrssBefore = _vmrssUsageBefore;
+    report.vmrssAfter = _vmrssUsageAfter;
+    report.writeJSON(CFLOpt::statFName(), "vf");
 }
 
 
@@ -8,6 +8,8 @@
  */
 
 #include "VFA/VFAnalysis.h"
+#include "CFLSolver/BatchQuery.h"
+#include "CFLSolver/CFLComponents.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -17,41 +19,73 @@ using namespace SVFUtil;
 
 void VFAnalysis::initialize()
 {
+    double readStart = VFAStat::getClk();
     setGraph(new IVFG());
     graph()->readGraph(graphName);
 
     stat = new VFAStat(this);
+    stat->report.phaseTimes[StatReport::Read] = (stat->getClk() - readStart) / TIMEINTERVAL;
+    enterPhase(StatReport::Simplify);
     stat->setMemUsageBefore();
 
     /// Graph simplification
     simplifyGraph();
     /// initialize online solver
-    initSolver();
+    if (CFLOpt::profileRules())
+        profile = new DerivationProfile();
+    enterPhase(StatReport::InitSolver);
+    double initStart = stat->getClk();
+    if (CFLOpt::wcc())
+        decompose();
+    else
+        initSolver();
+    stat->report.phaseTimes[StatReport::InitSolver] = (stat->getClk() - initStart) / TIMEINTERVAL;
 }
 
 
 void VFAnalysis::analyze()
 {
-    initialize();
-
     std::thread th(VFAnalysis::timer);     // timer thread
+    if (!CFLOpt::checkpointFName().empty())
+        Checkpoint::catchSignals();
+    if (CFLOpt::progressInterval())
+        sampler = new ProgressSampler(CFLOpt::progressInterval(), CFLOpt::progressFName());
+    initialize();
+    std::string ckptKey = graphName + " " + std::to_string(graph()->getTotalNodeNum());
+    Checkpoint::resume(this, ckptKey);
+    enterPhase(StatReport::Solve);
+    publishProgress();
 
     /// Start solving
     double propHorStart = stat->getClk();
 
-    do
+    if (CFLOpt::wcc())
     {
         stat->numOfIteration++;
-        reanalyze = false;
         if (CFLOpt::solveCFL())
-            solve();
-    } while (reanalyze);
+            solveComponents();
+    }
+    else
+    {
+        do
+        {
+            stat->numOfIteration++;
+            reanalyze = false;
+            if (CFLOpt::solveCFL())
+                solve();
+        } while (reanalyze && !Checkpoint::isPreempted());
+    }
 
+    publishProgress();
+    if (Checkpoint::isPreempted())
+        Checkpoint::suspend(this, ckptKey);
     double propHorEnd = stat->getClk();
     stat->timeOfSolving += (propHorEnd - propHorStart) / TIMEINTERVAL;
 
     /// Finalize the analysis
     finalize();
+    delete sampler;
+    sampler = nullptr;
 
     pthread_cancel(th.native_handle());     // kill timer
     th.join();
@@ -62,7 +96,15 @@ void VFAnalysis::finalize()
 {
     stat->setMemUsageAfter();
 
+    if (CFLOpt::materialize())
+        materializeResults();
     dumpStat();
+    if (!CFLOpt::sPairsFName().empty() || !CFLOpt::queryFName().empty())
+        outputValueFlowPairs();
+    for (auto comp : components)
+        if (profile && comp->profile)
+            profile->merge(*comp->profile);
+    dumpProfile();
     if (!CFLOpt::outGraphFName().empty())
         graph()->writeGraph(CFLOpt::outGraphFName());
 }
@@ -77,6 +119,13 @@ bool VFAnalysis::pushIntoWorklist(NodeID src, NodeID dst, Label ty)
 }
 
 
+std::string VFAnalysis::getSymbolName(CFGSymbTy symb)
+{
+    static const char* symbolNames[] = {"fault", "a", "call_i", "ret_i", "A", "B", "Cl_i"};
+    return symb <= Cl ? symbolNames[symb] : std::to_string(symb);
+}
+
+
 bool VFAnalysis::checkAndAddEdge(NodeID src, NodeID dst, Label lbl)
 {
     if (!lbl.first)
@@ -107,17 +156,156 @@ NodeBS VFAnalysis::checkAndAddEdges(const NodeBS& srcSet, NodeID dst, Label lbl)
 }
 
 
+/*!
+ * Summary edges are counted by the data store on insertion
+ */
 void VFAnalysis::countSumEdges()
 {
-    stat->numOfSumEdges = 0;
+    materializeResults();
+
+    stat->numOfSumEdges = cflData()->getNumOfEdges();
+    stat->numOfSEdges += cflData()->getNumOfEdges(A);
+}
+
+
+void VFAnalysis::materializeResults()
+{
+    if (materialized)
+        return;
+
+    enterPhase(StatReport::Materialize);
+    double startClk = stat->getClk();
+    if (components.empty())
+        materialize();
+    else
+        CFLComponents::runInParallel(components.size(), [this](u32_t i)
+        { components[i]->materializeResults(); });
+    materialized = true;
+    stat->report.phaseTimes[StatReport::Materialize] = (stat->getClk() - startClk) / TIMEINTERVAL;
+}
+
 
-    for (auto iter1 = cflData()->begin(); iter1 != cflData()->end(); ++iter1)
-        for (auto& iter2 : iter1->second)
+void VFAnalysis::collectValueFlowPairs(PairMap& pairs)
+{
+    for (VFAnalysis* comp : components)
+        comp->collectValueFlowPairs(pairs);
+    addValueFlowPairs(cflData(), pairs);
+}
+
+
+void VFAnalysis::addValueFlowPairs(CFLData* data, PairMap& pairs)
+{
+    for (auto& iter : data->getSuccMap())
+    {
+        auto aIt = iter.second.find(Label(A, 0));
+        if (aIt != iter.second.end() && !aIt->second.empty())
+            pairs[iter.first] |= aIt->second;
+    }
+}
+
+
+/*!
+ * The pairs are collected between reps. A rep is reached with all the original nodes merged into it,
+ * and reaches what the nodes of its SCC reach. A node folded into its predecessor only reaches part
+ * of what the rep reaches, so it is left out of the sources.
+ */
+void VFAnalysis::expandMergedPairs(PairMap& pairs)
+{
+    if (!graph()->hasMergedNodes())
+        return;
+
+    PairMap expanded;
+    for (auto& iter : pairs)
+    {
+        NodeBS dsts;
+        for (NodeID dst : iter.second)
+            dsts |= graph()->subNodeIds(dst);
+        NodeBS srcs = graph()->subNodeIds(iter.first);
+        if (ivfgFold)
+            srcs.intersectWithComplement(ivfgFold->getFoldedNodes());
+        for (NodeID src : srcs)
+            expanded[src] |= dsts;
+    }
+    pairs.swap(expanded);
+}
+
+
+void VFAnalysis::outputValueFlowPairs()
+{
+    PairMap pairs;
+    collectValueFlowPairs(pairs);
+    expandMergedPairs(pairs);
+
+    const std::string& fName = CFLOpt::sPairsFName();
+    if (!fName.empty()
+        && !PairWriter::writePairs(fName, pairs, CFLOpt::binaryPairs() ? PairWriter::Binary : PairWriter::Text))
+        std::cout << "error writing " << fName << std::endl;
+    if (!CFLOpt::queryFName().empty())
+        BatchQuery::answer(pairs, "value-flow");
+}
+
+
+/*!
+ * Each task of weakly connected components gets its own solver, graph copy and data store
+ */
+void VFAnalysis::decompose()
+{
+    CFLComponents wcc;
+    wcc.decompose(graph(), CFLComponents::numOfThreads() * 4);
+    stat->numOfComponents = wcc.getNumOfComponents();
+
+    for (auto& nodes : wcc.getTasks())
+    {
+        IVFG* subGraph = new IVFG();
+        subGraph->copyBuild(*graph(), nodes);
+
+        VFAnalysis* comp = createComponentSolver();
+        comp->setGraph(subGraph);
+        comp->stat = new VFAStat(comp);
+        if (profile)
+            comp->profile = new DerivationProfile();
+        comp->sampler = sampler;
+        components.push_back(comp);
+    }
+
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    {
+        components[i]->initSolver();
+        components[i]->publishProgress();
+    });
+}
+
+
+void VFAnalysis::solveComponents()
+{
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    {
+        VFAnalysis* comp = components[i];
+        do
         {
-            stat->numOfSumEdges += iter2.second.count();
-            if (iter2.first.first == A)
-                stat->numOfSEdges += iter2.second.count();
-        }
+            comp->stat->numOfIteration++;
+            comp->reanalyze = false;
+            comp->solve();
+        } while (comp->reanalyze && !Checkpoint::isPreempted());
+        comp->publishProgress();
+    });
+}
+
+
+void VFAnalysis::countComponentSumEdges()
+{
+    materializeResults();
+    CFLComponents::runInParallel(components.size(), [this](u32_t i)
+    { components[i]->countSumEdges(); });
+
+    stat->numOfSumEdges = 0;
+    for (VFAnalysis* comp : components)
+    {
+        stat->checks += comp->stat->checks;
+        stat->numOfSumEdges += comp->stat->numOfSumEdges;
+        stat->numOfSEdges += comp->stat->numOfSEdges;
+        stat->numOfECGEdges += comp->stat->numOfECGEdges;
+    }
 }
 
 
@@ -175,6 +363,7 @@ void StdVFA::initSolver()
         {
             checkAndAddEdge(srcId, dstId, std::make_pair(ret, edge->getEdgeIdx()));
             pushIntoWorklist(srcId, dstId, std::make_pair(ret, edge->getEdgeIdx()));
+            retData.addEdge(srcId, dstId, edge->getEdgeIdx());
         }
     }
 
@@ -186,3 +375,53 @@ void StdVFA::initSolver()
         pushIntoWorklist(nodeId, nodeId, std::make_pair(A, 0));
     }
 }
+
+
+/*!
+ * Cl_i and ret_i only meet in Cl_i ret_i, so both sides are looked up by callsite
+ * instead of scanning every label of the adjacent node. As this covers every derivation
+ * from a Cl_i or ret_i edge, the fan-outs and derivations are profiled here as in CFLBase.
+ */
+void StdVFA::processCFLItem(CFLItem item)
+{
+    Label lbl = item.label();
+
+    if (lbl.first == Cl)
+    {
+        const NodeBS& dsts = retData.getSuccs(item.dst(), lbl.second);
+        if (profile)
+            profile->addFanOut(DerivationProfile::Succ, dsts.count());
+        for (Label newTy : binarySumm(lbl, Label(ret, lbl.second)))
+        {
+            u64_t numOfNewFacts = 0;
+            for (NodeID dst : dsts)
+                if (checkAndAddEdge(item.src(), dst, newTy))
+                {
+                    pushIntoWorklist(item.src(), dst, newTy);
+                    numOfNewFacts++;
+                }
+            if (profile && newTy.first)
+                profile->addDerivations(newTy.first, Cl, ret, dsts.count(), numOfNewFacts);
+        }
+    }
+    else if (lbl.first == ret)
+    {
+        const NodeBS& srcs = cflData()->getPreds(item.src(), Label(Cl, lbl.second));
+        if (profile)
+            profile->addFanOut(DerivationProfile::Pred, srcs.count());
+        for (Label newTy : binarySumm(Label(Cl, lbl.second), lbl))
+        {
+            u64_t numOfNewFacts = 0;
+            for (NodeID src : srcs)
+                if (checkAndAddEdge(src, item.dst(), newTy))
+                {
+                    pushIntoWorklist(src, item.dst(), newTy);
+                    numOfNewFacts++;
+                }
+            if (profile && newTy.first)
+                profile->addDerivations(newTy.first, Cl, ret, srcs.count(), numOfNewFacts);
+        }
+    }
+    else
+        CFLBase::processCFLItem(item);
+}
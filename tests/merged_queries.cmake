@@ -0,0 +1,52 @@
+# Checks that the pairs written and the queries answered after merging nodes (-scc, -pe, ...) cover
+# the original nodes, i.e., agree with the run without merging.
+#
+#   cmake -DTOOL=<aa|vf binary> -DSOLVER=<-pocr|-focr|...> -DMERGE=<merging options> -DGRAPH=<graph>
+#         -DWORK_DIR=<dir> -P merged_queries.cmake
+
+function(run_tool)
+    execute_process(COMMAND ${TOOL} ${ARGN}
+            RESULT_VARIABLE result
+            OUTPUT_QUIET)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "${TOOL} ${ARGN} exited with ${result}")
+    endif ()
+endfunction()
+
+separate_arguments(MERGE)
+file(MAKE_DIRECTORY ${WORK_DIR})
+set(ref ${WORK_DIR}/ref.txt)
+set(merged ${WORK_DIR}/merged.txt)
+
+# queries over a grid of node pairs, mostly negative
+set(queries "")
+foreach (src RANGE 0 4000 97)
+    foreach (dst RANGE 0 4000 89)
+        string(APPEND queries "${src} ${dst}\n")
+    endforeach ()
+endforeach ()
+file(WRITE ${WORK_DIR}/grid.txt "${queries}")
+
+run_tool(${SOLVER} -write-spairs=${ref} ${GRAPH})
+run_tool(${SOLVER} ${MERGE} -write-spairs=${merged} -queries=${ref} -query-out=${WORK_DIR}/merged.pos ${GRAPH})
+run_tool(-query-result=${ref} -queries=${WORK_DIR}/grid.txt -query-out=${WORK_DIR}/ref.grid)
+run_tool(${SOLVER} ${MERGE} -queries=${WORK_DIR}/grid.txt -query-out=${WORK_DIR}/merged.grid ${GRAPH})
+
+file(READ ${ref} refPairs)
+file(READ ${merged} mergedPairs)
+if (NOT refPairs STREQUAL mergedPairs)
+    message(FATAL_ERROR "the pairs written with ${MERGE} differ from ${ref}")
+endif ()
+
+# every pair of the unmerged result is a positive query
+file(READ ${WORK_DIR}/merged.pos answers)
+string(FIND "${answers}" "\t0\n" negative)
+if (refPairs STREQUAL "" OR NOT negative EQUAL -1)
+    message(FATAL_ERROR "a pair of ${ref} is answered negatively with ${MERGE}")
+endif ()
+
+file(READ ${WORK_DIR}/ref.grid refAnswers)
+file(READ ${WORK_DIR}/merged.grid mergedAnswers)
+if (NOT refAnswers STREQUAL mergedAnswers)
+    message(FATAL_ERROR "the queries of grid.txt are answered differently with ${MERGE}")
+endif ()
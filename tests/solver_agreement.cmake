@@ -0,0 +1,29 @@
+# Checks that cfl derives the same S pairs under each variant as under the reference options.
+#
+#   cmake -DTOOL=<cfl binary> -DREF=<reference options> -DVARIANTS=<options|options|...>
+#         -DGRAMMAR=<grammar> -DGRAPH=<graph> -DWORK_DIR=<dir> -P solver_agreement.cmake
+
+function(write_pairs options out)
+    separate_arguments(options)
+    execute_process(COMMAND ${TOOL} ${options} -write-spairs=${out} ${GRAMMAR} ${GRAPH}
+            RESULT_VARIABLE result
+            OUTPUT_QUIET)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "${TOOL} ${options} ${GRAMMAR} ${GRAPH} exited with ${result}")
+    endif ()
+endfunction()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+write_pairs("${REF}" ${WORK_DIR}/ref.txt)
+
+string(REPLACE "|" ";" VARIANTS "${VARIANTS}")
+set(i 0)
+foreach (variant ${VARIANTS})
+    math(EXPR i "${i} + 1")
+    write_pairs("${variant}" ${WORK_DIR}/variant${i}.txt)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${WORK_DIR}/ref.txt ${WORK_DIR}/variant${i}.txt
+            RESULT_VARIABLE differ)
+    if (differ)
+        message(FATAL_ERROR "${variant} derives other S pairs than ${REF} on ${GRAMMAR} ${GRAPH}")
+    endif ()
+endforeach ()
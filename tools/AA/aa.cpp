@@ -6,6 +6,8 @@
 
 #include "SVF-LLVM/LLVMUtil.h"
 #include "AA/AliasAnalysis.h"
+#include "CFLSolver/BatchQuery.h"
+#include "CFLSolver/SolverSelector.h"
 
 using namespace SVF;
 
@@ -15,6 +17,8 @@ static Option<bool> Gspan_AA("gspan", "Graspan alias analysis", false);
 static Option<bool> Gr_AA("gr", "Grammar rewritting alias analysis", false);
 static Option<bool> GrGspan_AA("grgspan", "Grammar rewritting Graspan alias analysis", false);
 static Option<bool> Focr_AA("focr", "FOCR alias analysis", false);
+static Option<bool> BSFocr_AA("bsecg", "FOCR alias analysis with bit set-based ECG", false);
+static Option<bool> Auto_AA("auto", "Select the alias analysis solver and simplifications from input features", false);
 
 
 int main(int argc, char** argv)
@@ -26,6 +30,23 @@ int main(int argc, char** argv)
     processArgs(argc, argv, arg_num, arg_vec, inFileVec);
     OptionBase::parseOptions(arg_num, arg_vec, "Alias analysis\n", "[options] <input>");
 
+    /// answer the queries over a saved result instead of solving
+    if (!CFLOpt::queryResultFName().empty())
+        return BatchQuery::answerSaved("alias") ? 0 : 1;
+
+    if (Auto_AA())
+    {
+        SolverSelector selector(arg_num, arg_vec);
+        SolverSelector::SolverTy solver = selector.selectAA(inFileVec[0]);
+        selector.printDecision();
+        if (solver == SolverSelector::Focr)
+            Focr_AA.setValue(true);
+        else if (solver == SolverSelector::Pocr)
+            Pocr_AA.setValue(true);
+        else if (solver == SolverSelector::Std)
+            Default_AA.setValue(true);
+    }
+
     AliasAnalysis* aa;
     if (Default_AA())
     {
@@ -57,6 +78,11 @@ int main(int argc, char** argv)
         aa = new FocrAA(inFileVec[0]);
         aa->analyze();
     }
+    else if (BSFocr_AA())
+    {
+        aa = new BSFocrAA(inFileVec[0]);
+        aa->analyze();
+    }
     else    // pocr is the default solver
     {
         aa = new PocrAA(inFileVec[0]);
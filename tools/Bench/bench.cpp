@@ -0,0 +1,303 @@
+/*
+ // Benchmark of all solver variants over a corpus of PEGs and VFGs
+ //
+ // Every variant of aa, vf and cfl is run on every graph of the corpus in a child process,
+ // recording wall time, peak RSS and the #Checks/#SumEdges/result statistics it prints.
+ // Variants of one tool must agree on the result of each graph.
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "CFLData/BasicUtils.h"
+#include "Util/Options.h"
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <signal.h>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace SVF;
+
+static Option<u32_t> Reps("reps", "Number of repetitions of each run", 3);
+static Option<u32_t> TimeLimit("time-limit", "Time limit of each run in seconds", 300);
+static Option<u32_t> MaxGraphKB("max-graph-kb", "Skip graph files larger than this size in KB (0 for no limit)", 0);
+static Option<std::string> Report("report", "Write the report into specified file", "bench.json");
+static Option<std::string> Tools("tools", "Tools to benchmark, separated by commas", "aa,vf,cfl");
+
+/// A solver variant of a tool
+struct Variant
+{
+    std::string tool;
+    std::string flag;
+    std::string grammar;        // grammar/RSM file in the corpus for cfl
+    std::string graphExt;       // graph files it runs on
+    bool checkResult;           // whether it computes the result (Graspan variants do not count S edges)
+};
+
+/// A measured run
+struct Run
+{
+    const Variant* variant;
+    std::string graph;
+    std::string status;         // ok, timeout, or failed
+    std::vector<double> wallTimes;
+    long peakRSSKB = 0;
+    std::map<std::string, std::string> stats;
+};
+
+static const std::vector<Variant> variants = {
+        {"aa", "std", "", ".peg", true},
+        {"aa", "pocr", "", ".peg", true},
+        {"aa", "focr", "", ".peg", true},
+        {"aa", "bsecg", "", ".peg", true},
+        {"aa", "gspan", "", ".peg", false},
+        {"aa", "gr", "", ".peg", true},
+        {"aa", "grgspan", "", ".peg", false},
+        {"vf", "std", "", ".vfg", true},
+        {"vf", "pocr", "", ".vfg", true},
+        {"vf", "focr", "", ".vfg", true},
+        {"vf", "bsecg", "", ".vfg", true},
+        {"vf", "gspan", "", ".vfg", false},
+        {"vf", "gr", "", ".vfg", true},
+        {"vf", "grgspan", "", ".vfg", false},
+        {"cfl", "std", "aa.cfg", ".peg", true},
+        {"cfl", "pocr", "aa.cfg", ".peg", true},
+        {"cfl", "hpocr", "aa.cfg", ".peg", true},
+        {"cfl", "focr", "aa.cfg", ".peg", true},
+        {"cfl", "tr", "aa.cfg", ".peg", true},
+        {"cfl", "bsecg", "aa.cfg", ".peg", true},
+        {"cfl", "rsm", "aa.rsm", ".peg", true},
+        {"cfl", "std", "vf.cfg", ".vfg", true},
+        {"cfl", "pocr", "vf.cfg", ".vfg", true},
+        {"cfl", "hpocr", "vf.cfg", ".vfg", true},
+        {"cfl", "focr", "vf.cfg", ".vfg", true},
+        {"cfl", "tr", "vf.cfg", ".vfg", true},
+        {"cfl", "bsecg", "vf.cfg", ".vfg", true},
+        {"cfl", "rsm", "vf.rsm", ".vfg", true},
+};
+
+/// The statistic holding the result of each tool
+static std::string resultKey(const std::string& tool)
+{
+    return tool == "cfl" ? "#CountEdges" : "#SEdges";
+}
+
+
+/*!
+ * Run a command with its output redirected into outFile, killing it after the time limit
+ */
+static std::string runCommand(const std::vector<std::string>& args, const std::string& outFile,
+                              double& wallTime, long& maxRSSKB)
+{
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(outFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+
+        std::vector<char*> argv;
+        for (auto& arg : args)
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    struct rusage usage;
+    bool timeout = false;
+    while (wait4(pid, &status, WNOHANG, &usage) == 0)
+    {
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed > TimeLimit())
+        {
+            kill(pid, SIGKILL);
+            wait4(pid, &status, 0, &usage);
+            timeout = true;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    maxRSSKB = usage.ru_maxrss;
+    if (timeout)
+        return "timeout";
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return "failed";
+    return "ok";
+}
+
+
+/*!
+ * Statistics are printed as "key value" lines; later lines override earlier ones
+ */
+static void readStats(const std::string& outFile, std::map<std::string, std::string>& stats)
+{
+    std::ifstream in(outFile);
+    std::string line;
+    while (getline(in, line))
+    {
+        std::istringstream ss(line);
+        std::string key, value, rest;
+        if (!(ss >> key >> value) || (ss >> rest))
+            continue;
+        if (key[0] == '#' || key.find("Time") != std::string::npos || key.find("VmrssInGB") != std::string::npos)
+            stats[key] = value;
+    }
+}
+
+
+static std::vector<std::string> listGraphs(const std::string& dir)
+{
+    std::vector<std::string> graphs;
+    DIR* d = opendir(dir.c_str());
+    if (!d)
+        return graphs;
+    while (struct dirent* entry = readdir(d))
+    {
+        std::string name = entry->d_name;
+        if (name.size() > 4 && (name.substr(name.size() - 4) == ".peg" || name.substr(name.size() - 4) == ".vfg"))
+            graphs.push_back(name);
+    }
+    closedir(d);
+    std::sort(graphs.begin(), graphs.end());
+    return graphs;
+}
+
+
+static std::string jsonStr(const std::string& s)
+{
+    std::string ret = "\"";
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            ret += '\\';
+        ret += c;
+    }
+    return ret + "\"";
+}
+
+
+static void writeReport(const std::vector<Run>& runs, const std::vector<std::string>& mismatches)
+{
+    std::ofstream out(Report());
+    out << "{\n  \"reps\": " << Reps() << ",\n  \"runs\": [";
+    for (u32_t i = 0; i < runs.size(); ++i)
+    {
+        const Run& run = runs[i];
+        std::vector<double> times = run.wallTimes;
+        std::sort(times.begin(), times.end());
+        double median = times.empty() ? 0 : times[times.size() / 2];
+
+        out << (i ? "," : "") << "\n    {\"tool\": " << jsonStr(run.variant->tool)
+            << ", \"variant\": " << jsonStr(run.variant->flag)
+            << ", \"grammar\": " << jsonStr(run.variant->grammar)
+            << ", \"graph\": " << jsonStr(run.graph)
+            << ", \"status\": " << jsonStr(run.status)
+            << ", \"medianWallTime\": " << median
+            << ", \"wallTimes\": [";
+        for (u32_t t = 0; t < run.wallTimes.size(); ++t)
+            out << (t ? ", " : "") << run.wallTimes[t];
+        out << "], \"peakRSSKB\": " << run.peakRSSKB << ", \"stats\": {";
+        bool first = true;
+        for (auto& stat : run.stats)
+        {
+            out << (first ? "" : ", ") << jsonStr(stat.first) << ": " << jsonStr(stat.second);
+            first = false;
+        }
+        out << "}}";
+    }
+    out << "\n  ],\n  \"mismatches\": [";
+    for (u32_t i = 0; i < mismatches.size(); ++i)
+        out << (i ? ", " : "") << "\n    " << jsonStr(mismatches[i]);
+    out << "\n  ]\n}\n";
+}
+
+
+int main(int argc, char** argv)
+{
+    int arg_num = 0;
+    char** arg_vec = new char* [argc];
+    std::vector<std::string> inFileVec;
+    processArgs(argc, argv, arg_num, arg_vec, inFileVec);
+    OptionBase::parseOptions(arg_num, arg_vec, "Solver benchmark\n", "[options] <corpus dir>");
+
+    std::string corpus = inFileVec.empty() ? "tests" : inFileVec[0];
+    std::string binDir = argv[0];
+    binDir = binDir.find('/') == std::string::npos ? "." : binDir.substr(0, binDir.rfind('/'));
+    std::string outFile = Report() + ".out";
+    std::string tools = "," + Tools() + ",";
+
+    std::vector<Run> runs;
+    for (const std::string& graph : listGraphs(corpus))
+    {
+        std::string graphPath = corpus + "/" + graph;
+        std::ifstream gFile(graphPath, std::ios::ate | std::ios::binary);
+        if (MaxGraphKB() && gFile.tellg() > (std::streamoff) MaxGraphKB() * 1024)
+            continue;
+
+        for (const Variant& variant : variants)
+        {
+            if (tools.find("," + variant.tool + ",") == std::string::npos
+                || graph.substr(graph.size() - 4) != variant.graphExt)
+                continue;
+
+            std::vector<std::string> args = {binDir + "/" + variant.tool, "-" + variant.flag};
+            if (!variant.grammar.empty())
+                args.push_back(corpus + "/" + variant.grammar);
+            args.push_back(graphPath);
+
+            Run run;
+            run.variant = &variant;
+            run.graph = graph;
+            run.status = "ok";
+            for (u32_t rep = 0; rep < Reps() && run.status == "ok"; ++rep)
+            {
+                double wallTime;
+                long maxRSSKB;
+                run.status = runCommand(args, outFile, wallTime, maxRSSKB);
+                run.wallTimes.push_back(wallTime);
+                run.peakRSSKB = std::max(run.peakRSSKB, maxRSSKB);
+                if (run.status == "ok")
+                    readStats(outFile, run.stats);
+            }
+
+            std::cout << variant.tool << " -" << variant.flag << " " << variant.grammar << " " << graph << "\t"
+                      << run.status << "\t" << run.wallTimes.back() << "s\t" << run.peakRSSKB << "KB\t"
+                      << resultKey(variant.tool) << " " << run.stats[resultKey(variant.tool)] << std::endl;
+            runs.push_back(std::move(run));
+        }
+    }
+    unlink(outFile.c_str());
+
+    /// the variants of one tool must agree on the result of each graph
+    std::vector<std::string> mismatches;
+    std::map<std::pair<std::string, std::string>, std::pair<std::string, const Run*>> results;
+    for (const Run& run : runs)
+    {
+        auto rIt = run.stats.find(resultKey(run.variant->tool));
+        if (run.status != "ok" || !run.variant->checkResult || rIt == run.stats.end())
+            continue;
+        const std::string& result = rIt->second;
+        auto it = results.emplace(std::make_pair(run.variant->tool, run.graph), std::make_pair(result, &run)).first;
+        if (it->second.first != result)
+            mismatches.push_back(run.variant->tool + " " + run.graph + ": -" + it->second.second->variant->flag
+                                 + " " + it->second.first + " vs -" + run.variant->flag + " " + result);
+    }
+
+    writeReport(runs, mismatches);
+    for (auto& mismatch : mismatches)
+        std::cout << "Mismatch: " << mismatch << std::endl;
+    std::cout << runs.size() << " runs, " << mismatches.size() << " mismatches, report written into " << Report() << std::endl;
+
+    return mismatches.empty() ? 0 : 1;
+}
@@ -4,6 +4,8 @@
 
 #include "SVF-LLVM/LLVMUtil.h"
 #include "CFLSolver/CFLSolver.h"
+#include "CFLSolver/BatchQuery.h"
+#include "CFLSolver/SolverSelector.h"
 
 using namespace SVF;
 
@@ -13,6 +15,9 @@ static Option<bool> HPocr_CFL("hpocr", "Hierarchical POCR CFL-reachability analy
 static Option<bool> Focr_CFL("focr", "Uni-directional CFL-reachability analysis", false);
 static Option<bool> Tr_CFL("trold", "Uni-directional CFL-reachability analysis", false);
 static Option<bool> TrFocr_CFL("tr", "Uni-directional CFL-reachability analysis", false);
+static Option<bool> BSFocr_CFL("bsecg", "Uni-directional CFL-reachability analysis with bit set-based ECGs", false);
+static Option<bool> RSM_CFL("rsm", "CFL-reachability analysis on a recursive state machine", false);
+static Option<bool> Auto_CFL("auto", "Select the CFL-reachability analysis solver and simplifications from input features", false);
 
 
 int main(int argc, char** argv)
@@ -24,6 +29,23 @@ int main(int argc, char** argv)
     processArgs(argc, argv, arg_num, arg_vec, inFileVec);
     OptionBase::parseOptions(arg_num, arg_vec, "CFL-reachability analysis\n", "[options] <input>");
 
+    /// answer the queries over a saved result instead of solving
+    if (!CFLOpt::queryResultFName().empty())
+        return BatchQuery::answerSaved("S") ? 0 : 1;
+
+    if (Auto_CFL())
+    {
+        SolverSelector selector(arg_num, arg_vec);
+        SolverSelector::SolverTy solver = selector.selectCFL(inFileVec[0], inFileVec[1]);
+        selector.printDecision();
+        if (solver == SolverSelector::Focr)
+            Focr_CFL.setValue(true);
+        else if (solver == SolverSelector::Pocr)
+            Pocr_CFL.setValue(true);
+        else if (solver == SolverSelector::Std)
+            Default_CFL.setValue(true);
+    }
+
     StdCFL* cfl;
 
     if (Default_CFL())
@@ -56,6 +78,16 @@ int main(int argc, char** argv)
         cfl = new TRFocrCFL(inFileVec[0],inFileVec[1]);
         cfl->analyze();
     }
+    else if (BSFocr_CFL())
+    {
+        cfl = new BSFocrCFL(inFileVec[0], inFileVec[1]);
+        cfl->analyze();
+    }
+    else if (RSM_CFL())
+    {
+        cfl = new RSMCFL(inFileVec[0], inFileVec[1]);
+        cfl->analyze();
+    }
     else
     {
         cfl = new StdCFL(inFileVec[0], inFileVec[1]);
@@ -0,0 +1,388 @@
+/*
+ // Generator of synthetic PEGs, VFGs and labeled graphs for scaling studies
+ //
+ // Graphs are written in the tab-separated format of the bundled graphs and streamed through
+ // a buffer, so graphs of 10^8 edges need no memory beyond the node permutation (if any).
+ // Random edges go forward in node order; cycles come only from the SCCs asked for.
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "CFLData/BasicUtils.h"
+#include "Util/Options.h"
+#include "Util/SVFUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using namespace SVF;
+
+static Option<std::string> Kind("kind", "Kind of graph: peg, vfg or generic", "vfg");
+static Option<u32_t> NumOfNodes("nodes", "Number of nodes", 10000);
+static Option<u32_t> NumOfEdges("edges", "Number of edges (lines) to write", 40000);
+static Option<u32_t> Seed("seed", "Seed of the generator", 1);
+static Option<u32_t> Window("window", "Random edges connect nodes at most this far apart in node order (0 for uniform)", 0);
+static Option<u32_t> SCCPercent("scc-percent", "Percentage of nodes lying on copy cycles", 0);
+static Option<u32_t> SCCSize("scc-size", "Number of nodes of each copy cycle", 8);
+static Option<std::string> Output("out", "Write the graph into specified file (stdout if empty)", "");
+static Option<bool> ShuffleIds("shuffle-ids", "Randomly permute the node IDs in the output", false);
+/// PEG
+static Option<std::string> LabelMix("label-mix", "Weights of assign, deref and field edges of PEGs", "a:25,d:32,f:43");
+static Option<u32_t> NumOfFields("fields", "Number of field offsets of PEGs", 16);
+static Option<u32_t> FieldSkew("field-skew", "Zipf exponent of the field offset distribution in percent", 100);
+/// VFG
+static Option<u32_t> NumOfCallsites("callsites", "Number of callsites of VFGs (0 for edges/20)", 0);
+static Option<u32_t> DyckDepth("dyck-depth", "Nesting depth of calls in VFGs", 4);
+static Option<u32_t> FuncSize("func-size", "Average number of nodes per function in VFGs", 64);
+/// generic
+static Option<u32_t> NumOfLabels("labels", "Number of labels of generic graphs", 4);
+static Option<u32_t> LabelSkew("label-skew", "Zipf exponent of the label distribution of generic graphs in percent", 0);
+
+
+/*!
+ * Buffered writer of edge lines, counting the edges of each label
+ */
+class EdgeWriter
+{
+private:
+    FILE* out;
+    std::vector<char> buf;
+    size_t pos;
+    std::vector<NodeID> perm;
+
+    inline void put(const char* s, size_t len)
+    {
+        if (pos + len > buf.size())
+            flush();
+        memcpy(buf.data() + pos, s, len);
+        pos += len;
+    }
+
+    inline void putNum(u64_t n)
+    {
+        char tmp[24];
+        int len = 0;
+        do
+        {
+            tmp[sizeof(tmp) - ++len] = '0' + n % 10;
+            n /= 10;
+        } while (n);
+        put(tmp + sizeof(tmp) - len, len);
+    }
+
+public:
+    u64_t numOfEdges;
+    std::vector<std::string> labels;
+    std::vector<u64_t> labelCounts;
+
+    EdgeWriter(FILE* _out) : out(_out), buf(1 << 20), pos(0), numOfEdges(0)
+    {}
+
+    ~EdgeWriter()
+    { flush(); }
+
+    inline void flush()
+    {
+        fwrite(buf.data(), 1, pos, out);
+        pos = 0;
+    }
+
+    void permute(u32_t numOfNodes, std::mt19937_64& rng)
+    {
+        perm.resize(numOfNodes);
+        for (NodeID i = 0; i < numOfNodes; ++i)
+            perm[i] = i;
+        std::shuffle(perm.begin(), perm.end(), rng);
+    }
+
+    inline u32_t addLabel(const std::string& lbl)
+    {
+        labels.push_back(lbl);
+        labelCounts.push_back(0);
+        return labels.size() - 1;
+    }
+
+    /// Write an edge, with the index column if idx is non-negative
+    inline void edge(NodeID src, NodeID dst, u32_t lblId, long idx = -1)
+    {
+        const std::string& lbl = labels[lblId];
+        putNum(perm.empty() ? src : perm[src]);
+        put("\t", 1);
+        putNum(perm.empty() ? dst : perm[dst]);
+        put("\t", 1);
+        put(lbl.data(), lbl.size());
+        if (idx >= 0)
+        {
+            put("\t", 1);
+            putNum(idx);
+        }
+        put("\n", 1);
+        numOfEdges++;
+        labelCounts[lblId]++;
+    }
+};
+
+
+/*!
+ * Sampler of a Zipf distribution over [0, n), uniform with exponent 0
+ */
+class ZipfSampler
+{
+private:
+    std::vector<double> cdf;
+
+public:
+    ZipfSampler(u32_t n, double exponent)
+    {
+        double sum = 0;
+        for (u32_t k = 1; k <= std::max<u32_t>(1, n); ++k)
+        {
+            sum += 1 / std::pow(k, exponent);
+            cdf.push_back(sum);
+        }
+        for (double& c : cdf)
+            c /= sum;
+    }
+
+    inline u32_t sample(std::mt19937_64& rng)
+    {
+        double r = std::uniform_real_distribution<double>(0, 1)(rng);
+        return std::min<size_t>(std::lower_bound(cdf.begin(), cdf.end(), r) - cdf.begin(), cdf.size() - 1);
+    }
+};
+
+
+/*!
+ * Random forward edges within node range [begin, end)
+ */
+class EdgeSampler
+{
+private:
+    std::mt19937_64& rng;
+
+    inline NodeID uniform(NodeID lo, NodeID hi)
+    { return std::uniform_int_distribution<NodeID>(lo, hi)(rng); }
+
+public:
+    EdgeSampler(std::mt19937_64& _rng) : rng(_rng)
+    {}
+
+    /// Return false if the range has a single node
+    inline bool sample(NodeID begin, NodeID end, NodeID& src, NodeID& dst)
+    {
+        if (end - begin < 2)
+            return false;
+        if (!Window() || end - begin <= Window())
+        {
+            src = uniform(begin, end - 1);
+            do
+                dst = uniform(begin, end - 1);
+            while (dst == src);
+            if (src > dst)
+                std::swap(src, dst);
+            return true;
+        }
+        src = uniform(begin, end - 2);
+        dst = std::min<NodeID>(end - 1, src + uniform(1, Window()));
+        return true;
+    }
+};
+
+
+/*!
+ * Copy cycles over the first scc-percent nodes of [begin, end), in groups of scc-size consecutive nodes
+ */
+template<typename EmitTy>
+static u64_t emitCycles(NodeID begin, NodeID end, EmitTy emit)
+{
+    u64_t cycleNodes = (u64_t) (end - begin) * SCCPercent() / 100;
+    u32_t size = std::max<u32_t>(2, SCCSize());
+    u64_t numOfEdges = 0;
+    for (u64_t first = 0; first + 2 <= cycleNodes; first += size)
+    {
+        u32_t len = std::min<u64_t>(size, cycleNodes - first);
+        if (len < 2)
+            break;
+        for (u32_t k = 0; k < len; ++k)
+        {
+            emit(begin + first + k, begin + first + (k + 1) % len);
+            numOfEdges++;
+        }
+    }
+    return numOfEdges;
+}
+
+
+/*!
+ * PEG edges come with their reverse "bar" edges: assign (a), deref (d) and field (f_i) edges
+ */
+static void generatePEG(EdgeWriter& writer, std::mt19937_64& rng)
+{
+    std::vector<double> weights = {0, 0, 0};
+    for (const std::string& item : SVFUtil::split(LabelMix(), ','))
+    {
+        std::vector<std::string> kv = SVFUtil::split(item, ':');
+        if (kv.size() != 2)
+            continue;
+        if (kv[0] == "a")
+            weights[0] = std::stod(kv[1]);
+        else if (kv[0] == "d")
+            weights[1] = std::stod(kv[1]);
+        else if (kv[0] == "f")
+            weights[2] = std::stod(kv[1]);
+    }
+    std::discrete_distribution<u32_t> labelDist(weights.begin(), weights.end());
+    ZipfSampler fieldDist(NumOfFields(), FieldSkew() / 100.0);
+    EdgeSampler edgeDist(rng);
+    u32_t a = writer.addLabel("a"), abar = writer.addLabel("abar");
+    u32_t d = writer.addLabel("d"), dbar = writer.addLabel("dbar");
+    u32_t f = writer.addLabel("f_i"), fbar = writer.addLabel("fbar_i");
+
+    u64_t numOfPairs = emitCycles(0, NumOfNodes(), [&](NodeID src, NodeID dst)
+    {
+        writer.edge(src, dst, a);
+        writer.edge(dst, src, abar);
+    });
+
+    NodeID src, dst;
+    for (; numOfPairs < NumOfEdges() / 2 && edgeDist.sample(0, NumOfNodes(), src, dst); ++numOfPairs)
+    {
+        switch (labelDist(rng))
+        {
+            case 0:
+                writer.edge(src, dst, a);
+                writer.edge(dst, src, abar);
+                break;
+            case 1:
+                writer.edge(src, dst, d);
+                writer.edge(dst, src, dbar);
+                break;
+            default:
+            {
+                u32_t offset = fieldDist.sample(rng);
+                writer.edge(src, dst, f, offset);
+                writer.edge(dst, src, fbar, offset);
+            }
+        }
+    }
+}
+
+
+/*!
+ * Functions of func-size nodes on dyck-depth + 1 levels, where the functions of one level are called
+ * by those of the level above, so matched call_i/ret_i pairs nest up to dyck-depth deep.
+ * A callsite i links a node of the caller to an entry node of the callee by call_i,
+ * and an exit node of the callee to a later node of the caller by ret_i.
+ */
+static void generateVFG(EdgeWriter& writer, std::mt19937_64& rng)
+{
+    u32_t numOfFuncs = std::max<u32_t>(1, NumOfNodes() / std::max<u32_t>(2, FuncSize()));
+    u32_t numOfLevels = std::min(DyckDepth() + 1, numOfFuncs);
+    auto funcBegin = [&](u32_t f)
+    { return (NodeID) ((u64_t) f * NumOfNodes() / numOfFuncs); };
+    auto levelBegin = [&](u32_t l)
+    { return (u32_t) ((u64_t) l * numOfFuncs / numOfLevels); };
+    auto uniform = [&](u32_t lo, u32_t hi)
+    { return std::uniform_int_distribution<u32_t>(lo, hi)(rng); };
+    EdgeSampler edgeDist(rng);
+    u32_t a = writer.addLabel("a"), call = writer.addLabel("call_i"), ret = writer.addLabel("ret_i");
+
+    u64_t numOfCallsites = NumOfCallsites() ? NumOfCallsites() : NumOfEdges() / 20;
+    if (numOfLevels < 2)
+        numOfCallsites = 0;
+    for (u64_t cs = 0; cs < numOfCallsites; ++cs)
+    {
+        u32_t caller = uniform(0, levelBegin(numOfLevels - 1) - 1);
+        u32_t level = 0;
+        while (levelBegin(level + 1) <= caller)
+            level++;
+        u32_t callee = uniform(levelBegin(level + 1), levelBegin(level + 2) - 1);
+
+        NodeID cBegin = funcBegin(callee), cEnd = funcBegin(callee + 1);
+        NodeID entry = cBegin + uniform(0, (cEnd - cBegin - 1) / 4);
+        NodeID exit = cEnd - 1 - uniform(0, (cEnd - cBegin - 1) / 4);
+        NodeID callNode, retNode;
+        if (!edgeDist.sample(funcBegin(caller), funcBegin(caller + 1), callNode, retNode))
+            callNode = retNode = funcBegin(caller);
+        writer.edge(callNode, entry, call, cs);
+        writer.edge(exit, retNode, ret, cs);
+    }
+
+    for (u32_t f = 0; f < numOfFuncs; ++f)
+        emitCycles(funcBegin(f), funcBegin(f + 1), [&](NodeID src, NodeID dst)
+        { writer.edge(src, dst, a); });
+
+    /// the remaining budget goes to intra-procedural value flows
+    NodeID src, dst;
+    u64_t budget = NumOfEdges() > writer.numOfEdges ? NumOfEdges() - writer.numOfEdges : 0;
+    for (u64_t e = 0; e < budget; ++e)
+    {
+        u32_t f = uniform(0, numOfFuncs - 1);
+        if (edgeDist.sample(funcBegin(f), funcBegin(f + 1), src, dst))
+            writer.edge(src, dst, a);
+    }
+}
+
+
+/*!
+ * Labels l0, l1, ... drawn from a Zipf distribution; cycles are labeled l0
+ */
+static void generateGeneric(EdgeWriter& writer, std::mt19937_64& rng)
+{
+    for (u32_t l = 0; l < std::max<u32_t>(1, NumOfLabels()); ++l)
+        writer.addLabel("l" + std::to_string(l));
+    ZipfSampler labelDist(writer.labels.size(), LabelSkew() / 100.0);
+    EdgeSampler edgeDist(rng);
+
+    emitCycles(0, NumOfNodes(), [&](NodeID src, NodeID dst)
+    { writer.edge(src, dst, 0); });
+
+    NodeID src, dst;
+    while (writer.numOfEdges < NumOfEdges() && edgeDist.sample(0, NumOfNodes(), src, dst))
+        writer.edge(src, dst, labelDist.sample(rng));
+}
+
+
+int main(int argc, char** argv)
+{
+    int arg_num = 0;
+    char** arg_vec = new char* [argc];
+    std::vector<std::string> inFileVec;
+    processArgs(argc, argv, arg_num, arg_vec, inFileVec);
+    OptionBase::parseOptions(arg_num, arg_vec, "Synthetic graph generator\n", "[options]");
+
+    FILE* out = Output().empty() ? stdout : fopen(Output().c_str(), "w");
+    if (!out)
+    {
+        std::cerr << "error opening " << Output() << std::endl;
+        return 1;
+    }
+
+    std::mt19937_64 rng(Seed());
+    EdgeWriter* writer = new EdgeWriter(out);
+    if (ShuffleIds())
+        writer->permute(NumOfNodes(), rng);
+
+    if (Kind() == "peg")
+        generatePEG(*writer, rng);
+    else if (Kind() == "vfg")
+        generateVFG(*writer, rng);
+    else if (Kind() == "generic")
+        generateGeneric(*writer, rng);
+    else
+    {
+        std::cerr << "unknown graph kind " << Kind() << std::endl;
+        return 1;
+    }
+
+    std::cerr << Kind() << ": #Node = " << NumOfNodes() << ", #Edge = " << writer->numOfEdges;
+    for (u32_t l = 0; l < writer->labels.size(); ++l)
+        std::cerr << ", #" << writer->labels[l] << " = " << writer->labelCounts[l];
+    std::cerr << std::endl;
+
+    delete writer;
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
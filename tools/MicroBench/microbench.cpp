@@ -0,0 +1,361 @@
+/*
+ // Micro-benchmark of the edge insertion primitives of the solvers
+ //
+ // CFLData::checkAndAddEdge, HybridData::addArc (meld) and the ECG/BSECG edge insertions
+ // are driven in isolation by synthetic patterns (chain, star, random DAG, clique) and by
+ // operation traces recorded with -record-trace or given as graph files,
+ // reporting ns per operation and heap bytes per fact.
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "CFLData/CFLData.h"
+#include "CFLData/ECG.h"
+#include "Util/Options.h"
+#include "Util/SVFUtil.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <malloc.h>
+#include <random>
+
+using namespace SVF;
+
+static Option<std::string> Patterns("patterns", "Synthetic patterns to run, separated by commas", "chain,star,dag,clique");
+static Option<std::string> Structs("structs", "Data structures to run, separated by commas", "cfldata,hybrid,ecg,iterecg,bsecg");
+static Option<u32_t> NumOfNodes("nodes", "Number of nodes of the chain, star and DAG patterns", 2000);
+static Option<u32_t> CliqueNodes("clique-nodes", "Number of nodes of the clique pattern", 150);
+static Option<u32_t> DagDegree("dag-degree", "Average out-degree of the DAG pattern", 4);
+static Option<u32_t> Seed("seed", "Seed of the random patterns", 1);
+static Option<u32_t> Reps("reps", "Number of repetitions of each run, the fastest is reported", 3);
+static Option<std::string> TraceLabel("trace-label", "Only replay the trace edges of this label (a label name, or name_index for one index) into the transitive structures", "");
+static Option<std::string> Report("report", "Write the results into specified JSON file", "");
+
+/// An edge insertion
+struct Op
+{
+    NodeID src;
+    NodeID dst;
+    CFGSymbTy lbl;
+};
+
+/// A sequence of edge insertions
+struct Workload
+{
+    std::string name;
+    std::vector<Op> ops;
+    std::vector<NodeID> nodes;
+    Map<std::string, CFGSymbTy> labels;
+    std::vector<std::string> labelNames;    // the label names without indices, by label id
+
+    void collectNodes()
+    {
+        Set<NodeID> nodeSet;
+        for (const Op& op : ops)
+        {
+            nodeSet.insert(op.src);
+            nodeSet.insert(op.dst);
+        }
+        nodes.assign(nodeSet.begin(), nodeSet.end());
+        std::sort(nodes.begin(), nodes.end());
+    }
+};
+
+/// A measured run
+struct Result
+{
+    std::string workload;
+    std::string structure;
+    u64_t ops = 0;
+    u64_t facts = 0;        // edges new to the structure, reachable pairs for the transitive ones
+    double seconds = 0;
+    u64_t bytes = 0;        // heap growth while the structure is alive
+};
+
+
+static u64_t heapInUse()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+
+/// Synthetic patterns
+//@{
+static Workload chainPattern(u32_t n)
+{
+    Workload w;
+    w.name = "chain";
+    for (NodeID i = 0; i + 1 < n; ++i)
+        w.ops.push_back({i, i + 1, 0});
+    return w;
+}
+
+/// The first half of the leaves point to the hub, which points to the second half
+static Workload starPattern(u32_t n)
+{
+    Workload w;
+    w.name = "star";
+    for (NodeID i = 1; i < n / 2; ++i)
+        w.ops.push_back({i, 0, 0});
+    for (NodeID i = n / 2; i < n; ++i)
+        w.ops.push_back({0, i, 0});
+    return w;
+}
+
+static Workload dagPattern(u32_t n, u32_t degree, std::mt19937& rng)
+{
+    Workload w;
+    w.name = "dag";
+    std::uniform_int_distribution<NodeID> dist(0, n - 1);
+    for (u32_t e = 0; e < n * degree; ++e)
+    {
+        NodeID src = dist(rng);
+        NodeID dst = dist(rng);
+        if (src != dst)
+            w.ops.push_back({std::min(src, dst), std::max(src, dst), 0});
+    }
+    std::shuffle(w.ops.begin(), w.ops.end(), rng);
+    return w;
+}
+
+static Workload cliquePattern(u32_t n, std::mt19937& rng)
+{
+    Workload w;
+    w.name = "clique";
+    for (NodeID i = 0; i < n; ++i)
+        for (NodeID j = 0; j < n; ++j)
+            if (i != j)
+                w.ops.push_back({i, j, 0});
+    std::shuffle(w.ops.begin(), w.ops.end(), rng);
+    return w;
+}
+//@}
+
+
+/*!
+ * Traces are lines of "src dst label [index]" separated by tabs, as recorded by -record-trace;
+ * PEG and VFG files are read as traces as well.
+ * A label with an index is keyed as "label_index"
+ */
+static bool readTrace(const std::string& fname, Workload& w)
+{
+    std::ifstream in(fname);
+    if (!in.is_open())
+        return false;
+
+    w.name = fname.substr(fname.rfind('/') + 1);
+    std::string line;
+    while (getline(in, line))
+    {
+        std::vector<std::string> vec = SVFUtil::split(line, '\t');
+        if (vec.size() < 3)
+            continue;
+        std::string key = vec.size() > 3 ? vec[2] + "_" + vec[3] : vec[2];
+        auto lIt = w.labels.emplace(key, w.labels.size());
+        if (lIt.second)
+            w.labelNames.push_back(vec[2]);
+        CFGSymbTy lbl = lIt.first->second;
+        w.ops.push_back({(NodeID) stoul(vec[0]), (NodeID) stoul(vec[1]), lbl});
+    }
+    return true;
+}
+
+
+/// Runs over each data structure, the transitive ones replay the ops of -trace-label only
+//@{
+static void runCFLData(const Workload& w, Result& res)
+{
+    u64_t heapBefore = heapInUse();
+    CFLData* data = new CFLData();
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Op& op : w.ops)
+        if (data->checkAndAddEdge(op.src, op.dst, Label(op.lbl, 0)))
+            res.facts++;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    res.ops = w.ops.size();
+    res.bytes = heapInUse() - heapBefore;
+    delete data;
+}
+
+static void runHybrid(const Workload& w, const std::vector<Op>& ops, Result& res)
+{
+    u64_t heapBefore = heapInUse();
+    HybridData* data = new HybridData();
+    for (NodeID n : w.nodes)
+        data->addInd(n, n);
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Op& op : ops)
+        for (auto& it : data->addArc(op.src, op.dst))
+            res.facts += it.second.count();
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    res.ops = ops.size();
+    res.bytes = heapInUse() - heapBefore;
+    delete data;
+}
+
+/// Edges are classified as in FocrAA::addArc
+static void runECG(const Workload& w, const std::vector<Op>& ops, bool iter, Result& res)
+{
+    u64_t heapBefore = heapInUse();
+    ECG* ecg = iter ? new IterECG() : new ECG();
+    for (NodeID n : w.nodes)
+        ecg->addNode(n);
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Op& op : ops)
+    {
+        if (ecg->isReachable(op.src, op.dst))
+            continue;
+        auto& newEdgeMap = ecg->isReachable(op.dst, op.src) ? ecg->insertBackEdge(op.src, op.dst)
+                                                            : ecg->insertForwardEdge(op.src, op.dst);
+        for (auto& it : newEdgeMap)
+            res.facts += it.second.count();
+    }
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    res.ops = ops.size();
+    res.bytes = heapInUse() - heapBefore;
+    delete ecg;
+}
+
+static void runBSECG(const Workload& w, const std::vector<Op>& ops, Result& res)
+{
+    u64_t heapBefore = heapInUse();
+    BSECG* bsecg = new BSECG();
+    for (NodeID n : w.nodes)
+        bsecg->addNode(n);
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Op& op : ops)
+    {
+        if (bsecg->isReachable(op.src, op.dst))
+            continue;
+        auto& newEdgeMap = bsecg->isReachable(op.dst, op.src) ? bsecg->insertBackEdge(op.src, op.dst)
+                                                              : bsecg->insertForthEdge(op.src, op.dst);
+        for (auto& it : newEdgeMap)
+            res.facts += it.second.count();
+    }
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    res.ops = ops.size();
+    res.bytes = heapInUse() - heapBefore;
+    delete bsecg;
+}
+//@}
+
+
+static Result run(const Workload& w, const std::vector<Op>& transOps, const std::string& structure)
+{
+    Result best;
+    for (u32_t rep = 0; rep < std::max<u32_t>(1, Reps()); ++rep)
+    {
+        Result res;
+        res.workload = w.name;
+        res.structure = structure;
+        if (structure == "cfldata")
+            runCFLData(w, res);
+        else if (structure == "hybrid")
+            runHybrid(w, transOps, res);
+        else if (structure == "ecg" || structure == "iterecg")
+            runECG(w, transOps, structure == "iterecg", res);
+        else if (structure == "bsecg")
+            runBSECG(w, transOps, res);
+
+        /// heap growth is measured on the first, cold run
+        if (rep == 0)
+            best = res;
+        else if (res.seconds < best.seconds)
+            best.seconds = res.seconds;
+    }
+    return best;
+}
+
+
+static void writeReport(const std::vector<Result>& results)
+{
+    std::ofstream out(Report());
+    out << "{\n  \"reps\": " << Reps() << ",\n  \"results\": [";
+    for (u32_t i = 0; i < results.size(); ++i)
+    {
+        const Result& res = results[i];
+        out << (i ? "," : "") << "\n    {\"workload\": \"" << res.workload
+            << "\", \"structure\": \"" << res.structure
+            << "\", \"ops\": " << res.ops
+            << ", \"facts\": " << res.facts
+            << ", \"seconds\": " << res.seconds
+            << ", \"nsPerOp\": " << (res.ops ? res.seconds * 1e9 / res.ops : 0)
+            << ", \"bytes\": " << res.bytes
+            << ", \"bytesPerFact\": " << (res.facts ? (double) res.bytes / res.facts : 0) << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+
+int main(int argc, char** argv)
+{
+    int arg_num = 0;
+    char** arg_vec = new char* [argc];
+    std::vector<std::string> inFileVec;
+    processArgs(argc, argv, arg_num, arg_vec, inFileVec);
+    OptionBase::parseOptions(arg_num, arg_vec, "Micro-benchmark of solver data structures\n", "[options] [trace files]");
+
+    std::vector<Workload> workloads;
+    std::mt19937 rng(Seed());
+    std::string patterns = "," + Patterns() + ",";
+    if (patterns.find(",chain,") != std::string::npos)
+        workloads.push_back(chainPattern(NumOfNodes()));
+    if (patterns.find(",star,") != std::string::npos)
+        workloads.push_back(starPattern(NumOfNodes()));
+    if (patterns.find(",dag,") != std::string::npos)
+        workloads.push_back(dagPattern(NumOfNodes(), DagDegree(), rng));
+    if (patterns.find(",clique,") != std::string::npos)
+        workloads.push_back(cliquePattern(CliqueNodes(), rng));
+    for (const std::string& fname : inFileVec)
+    {
+        Workload w;
+        if (!readTrace(fname, w))
+        {
+            std::cout << "error opening " << fname << std::endl;
+            return 1;
+        }
+        workloads.push_back(std::move(w));
+    }
+
+    std::vector<std::string> structs = SVFUtil::split(Structs(), ',');
+    std::vector<Result> results;
+    std::cout << std::left << std::setw(16) << "workload" << std::setw(10) << "struct" << std::right
+              << std::setw(12) << "ops" << std::setw(12) << "facts" << std::setw(12) << "ns/op"
+              << std::setw(12) << "ns/fact" << std::setw(12) << "bytes/fact" << std::endl;
+    for (Workload& w : workloads)
+    {
+        w.collectNodes();
+        std::vector<Op> transOps;
+        auto lIt = w.labels.find(TraceLabel());
+        for (const Op& op : w.ops)
+            if (TraceLabel().empty() || (lIt != w.labels.end() && op.lbl == lIt->second)
+                || (op.lbl < w.labelNames.size() && w.labelNames[op.lbl] == TraceLabel()))
+                transOps.push_back(op);
+
+        for (const std::string& structure : structs)
+        {
+            Result res = run(w, transOps, structure);
+            std::cout << std::left << std::setw(16) << res.workload << std::setw(10) << res.structure << std::right
+                      << std::setw(12) << res.ops << std::setw(12) << res.facts
+                      << std::setw(12) << std::fixed << std::setprecision(1)
+                      << (res.ops ? res.seconds * 1e9 / res.ops : 0)
+                      << std::setw(12) << (res.facts ? res.seconds * 1e9 / res.facts : 0)
+                      << std::setw(12) << (res.facts ? (double) res.bytes / res.facts : 0)
+                      << std::defaultfloat << std::endl;
+            results.push_back(res);
+        }
+    }
+
+    if (!Report().empty())
+        writeReport(results);
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ // Reader and converter of the result pairs written by -write-spairs
+ //
+ // Reads a pair file in either format, prints its numbers of sources and pairs, and converts it
+ // into the format given by -binary-pairs if -out is set. Records are streamed one source at a time.
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "CFLData/PairIO.h"
+#include "CFLSolver/CFLOpt.h"
+#include "Util/Options.h"
+
+using namespace SVF;
+
+static Option<std::string> Output("out", "Write the pairs into specified file", "");
+
+int main(int argc, char** argv)
+{
+    int arg_num = 0;
+    char** arg_vec = new char* [argc];
+    std::vector<std::string> inFileVec;
+    processArgs(argc, argv, arg_num, arg_vec, inFileVec);
+    OptionBase::parseOptions(arg_num, arg_vec, "Result pair reader\n", "[options] <pair file>");
+
+    if (inFileVec.empty())
+    {
+        std::cerr << "error: no pair file given" << std::endl;
+        return 1;
+    }
+
+    PairReader reader(inFileVec[0]);
+    if (!reader.isValid())
+    {
+        std::cerr << "error: cannot read " << inFileVec[0] << std::endl;
+        return 1;
+    }
+
+    PairWriter* writer = nullptr;
+    if (!Output().empty())
+        writer = new PairWriter(Output(), CFLOpt::binaryPairs() ? PairWriter::Binary : PairWriter::Text);
+
+    u64_t numOfSrcs = 0;
+    u64_t numOfPairs = 0;
+    NodeID src;
+    NodeBS dsts;
+    while (reader.next(src, dsts))
+    {
+        numOfSrcs++;
+        numOfPairs += dsts.count();
+        if (writer)
+            writer->write(src, dsts);
+    }
+
+    std::cout << "Format\t" << (reader.getFormat() == PairWriter::Binary ? "binary" : "text") << "\n";
+    std::cout << "#Sources\t" << numOfSrcs << "\n";
+    std::cout << "#Pairs\t" << numOfPairs << std::endl;
+
+    bool ok = reader.isValid();
+    if (!ok)
+        std::cerr << "error: " << inFileVec[0] << " is malformed" << std::endl;
+    if (writer && !writer->close())
+    {
+        std::cerr << "error writing " << Output() << std::endl;
+        ok = false;
+    }
+    delete writer;
+    return ok ? 0 : 1;
+}
@@ -6,6 +6,8 @@
 
 #include "SVF-LLVM/LLVMUtil.h"
 #include "VFA/VFAnalysis.h"
+#include "CFLSolver/BatchQuery.h"
+#include "CFLSolver/SolverSelector.h"
 
 using namespace SVF;
 
@@ -15,6 +17,8 @@ static Option<bool> Gspan_VFA("gspan", "Graspan valueflow analysis", false);
 static Option<bool> Gr_VFA("gr", "Grammar rewritting valueflow analysis", false);
 static Option<bool> GrGspan_VFA("grgspan", "Grammar rewritting Graspan valueflow analysis", false);
 static Option<bool> Focr_VFA("focr", "Transitive-reduction valueflow analysis", false);
+static Option<bool> BSFocr_VFA("bsecg", "FOCR valueflow analysis with bit set-based ECG", false);
+static Option<bool> Auto_VFA("auto", "Select the valueflow analysis solver and simplifications from input features", false);
 
 
 int main(int argc, char** argv)
@@ -26,6 +30,23 @@ int main(int argc, char** argv)
     processArgs(argc, argv, arg_num, arg_vec, inFileVec);
     OptionBase::parseOptions(arg_num, arg_vec, "Valueflow analysis\n", "[options] <input>");
 
+    /// answer the queries over a saved result instead of solving
+    if (!CFLOpt::queryResultFName().empty())
+        return BatchQuery::answerSaved("value-flow") ? 0 : 1;
+
+    if (Auto_VFA())
+    {
+        SolverSelector selector(arg_num, arg_vec);
+        SolverSelector::SolverTy solver = selector.selectVFA(inFileVec[0]);
+        selector.printDecision();
+        if (solver == SolverSelector::Focr)
+            Focr_VFA.setValue(true);
+        else if (solver == SolverSelector::Pocr)
+            Pocr_VFA.setValue(true);
+        else if (solver == SolverSelector::Std)
+            Default_VFA.setValue(true);
+    }
+
     VFAnalysis* vfa;
     if (Default_VFA())
     {
@@ -57,6 +78,11 @@ int main(int argc, char** argv)
         vfa = new FocrVFA(inFileVec[0]);
         vfa->analyze();
     }
+    else if (BSFocr_VFA())
+    {
+        vfa = new BSFocrVFA(inFileVec[0]);
+        vfa->analyze();
+    }
     else    // pocr is the default solver
     {
         vfa = new PocrVFA(inFileVec[0]);